@@ -8,6 +8,7 @@
 #include "autopick/autopick-finder.h"
 #include "autopick/autopick-dirty-flags.h"
 #include "autopick/autopick-entry.h"
+#include "autopick/autopick-list-index.h"
 #include "autopick/autopick-matcher.h"
 #include "autopick/autopick-util.h"
 #include "core/show-file.h"
@@ -32,18 +33,30 @@
  * @details
  * A function for Auto-picker/destroyer
  * Examine whether the object matches to the list of keywords or not.
+ * 種別・名称の条件で一致し得ないエントリは索引を用いて読み飛ばす.
  */
 int find_autopick_list(PlayerType *player_ptr, ItemEntity *o_ptr)
 {
-    if (o_ptr->bi_key.tval() == ItemKindType::GOLD) {
+    const auto tval = o_ptr->bi_key.tval();
+    if (tval == ItemKindType::GOLD) {
+        return -1;
+    }
+
+    auto &index = AutopickListIndex::get_instance();
+    const auto &candidates = index.get_candidates(tval);
+    if (candidates.empty()) {
         return -1;
     }
 
     auto item_name = describe_flavor(player_ptr, o_ptr, (OD_NO_FLAVOR | OD_OMIT_PREFIX | OD_NO_PLURAL));
     str_tolower(item_name.data());
-    for (auto i = 0U; i < autopick_list.size(); i++) {
-        const auto &entry = autopick_list[i];
-        if (is_autopick_match(player_ptr, o_ptr, entry, item_name)) {
+    index.match_names(item_name);
+    for (const auto i : candidates) {
+        if (!index.is_name_matched(i)) {
+            continue;
+        }
+
+        if (is_autopick_match(player_ptr, o_ptr, autopick_list[i], item_name)) {
             return i;
         }
     }
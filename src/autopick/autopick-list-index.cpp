@@ -0,0 +1,297 @@
+﻿#include "autopick/autopick-list-index.h"
+#include "autopick/autopick-flags-table.h"
+#include "autopick/autopick-util.h"
+#include "object/tval-types.h"
+#include "system/baseitem-info.h"
+#include <deque>
+
+AutopickListIndex AutopickListIndex::instance{};
+
+/*!
+ * @brief エントリが指定した種別のアイテムに一致し得るかを返す
+ * @param entry 自動拾いのエントリ
+ * @param tval アイテム種別
+ * @return 一致し得るならtrue
+ * @details is_autopick_match() の条件のうち、tval だけで判定できるものを調べる.
+ * 名詞の条件は check_item_features() と同じ順序で調べること.
+ */
+static bool can_match_tval(const autopick_type &entry, const ItemKindType tval)
+{
+    const BaseitemKey bi_key(tval);
+    if (entry.has(FLG_BOOSTED) && !bi_key.is_melee_weapon()) {
+        return false;
+    }
+
+    if (entry.has(FLG_UNIQUE) && (tval != ItemKindType::CORPSE) && (tval != ItemKindType::STATUE)) {
+        return false;
+    }
+
+    if (entry.has(FLG_HUMAN) && (tval != ItemKindType::CORPSE)) {
+        return false;
+    }
+
+    const auto is_book_order_specified = entry.has(FLG_FIRST) || entry.has(FLG_SECOND) || entry.has(FLG_THIRD) || entry.has(FLG_FOURTH);
+    if (is_book_order_specified && !bi_key.is_spell_book()) {
+        return false;
+    }
+
+    if (entry.has(FLG_WEAPONS)) {
+        return bi_key.is_weapon();
+    }
+
+    if (entry.has(FLG_FAVORITE_WEAPONS)) {
+        return true;
+    }
+
+    if (entry.has(FLG_ARMORS)) {
+        return bi_key.is_protector();
+    }
+
+    if (entry.has(FLG_MISSILES)) {
+        return bi_key.is_ammo();
+    }
+
+    if (entry.has(FLG_DEVICES)) {
+        return (tval == ItemKindType::SCROLL) || (tval == ItemKindType::STAFF) || (tval == ItemKindType::WAND) || (tval == ItemKindType::ROD);
+    }
+
+    if (entry.has(FLG_LIGHTS)) {
+        return tval == ItemKindType::LITE;
+    }
+
+    if (entry.has(FLG_JUNKS)) {
+        return (tval == ItemKindType::SKELETON) || (tval == ItemKindType::BOTTLE) || (tval == ItemKindType::JUNK) || (tval == ItemKindType::STATUE);
+    }
+
+    if (entry.has(FLG_CORPSES)) {
+        return (tval == ItemKindType::CORPSE) || (tval == ItemKindType::SKELETON);
+    }
+
+    if (entry.has(FLG_SPELLBOOKS)) {
+        return bi_key.is_spell_book();
+    }
+
+    if (entry.has(FLG_HAFTED)) {
+        return tval == ItemKindType::HAFTED;
+    }
+
+    if (entry.has(FLG_SHIELDS)) {
+        return tval == ItemKindType::SHIELD;
+    }
+
+    if (entry.has(FLG_BOWS)) {
+        return tval == ItemKindType::BOW;
+    }
+
+    if (entry.has(FLG_RINGS)) {
+        return tval == ItemKindType::RING;
+    }
+
+    if (entry.has(FLG_AMULETS)) {
+        return tval == ItemKindType::AMULET;
+    }
+
+    if (entry.has(FLG_SUITS)) {
+        return bi_key.is_armour();
+    }
+
+    if (entry.has(FLG_CLOAKS)) {
+        return tval == ItemKindType::CLOAK;
+    }
+
+    if (entry.has(FLG_HELMS)) {
+        return (tval == ItemKindType::CROWN) || (tval == ItemKindType::HELM);
+    }
+
+    if (entry.has(FLG_GLOVES)) {
+        return tval == ItemKindType::GLOVES;
+    }
+
+    if (entry.has(FLG_BOOTS)) {
+        return tval == ItemKindType::BOOTS;
+    }
+
+    return true;
+}
+
+AutopickListIndex &AutopickListIndex::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 索引を破棄し、次回の検索時に作り直させる
+ */
+void AutopickListIndex::invalidate()
+{
+    this->is_built = false;
+}
+
+/*!
+ * @brief 指定した種別のアイテムに一致し得るエントリの番号をリストの順に返す
+ * @param tval アイテム種別
+ * @return エントリ番号のリスト
+ */
+const std::vector<int> &AutopickListIndex::get_candidates(ItemKindType tval)
+{
+    this->update();
+    auto it = this->candidates.find(tval);
+    if (it != this->candidates.end()) {
+        return it->second;
+    }
+
+    std::vector<int> entry_indices;
+    for (auto i = 0U; i < autopick_list.size(); i++) {
+        if (can_match_tval(autopick_list[i], tval)) {
+            entry_indices.push_back(i);
+        }
+    }
+
+    return this->candidates.emplace(tval, std::move(entry_indices)).first->second;
+}
+
+/*!
+ * @brief アイテム名を1回走査し、全エントリの名称条件との一致を調べる
+ * @param item_name 小文字化したアイテム名
+ * @details 結果は次にこの関数を呼ぶまで is_name_matched() で参照できる.
+ * angband_strstr() と同じく、全角文字の途中から始まる一致は無視する.
+ */
+void AutopickListIndex::match_names(std::string_view item_name)
+{
+    this->update();
+    this->matched_anywhere.assign(this->pattern_lengths.size(), false);
+    this->matched_prefix.assign(this->pattern_lengths.size(), false);
+    if (const auto empty_idx = this->nodes[0].pattern_idx; empty_idx >= 0) {
+        this->matched_anywhere[empty_idx] = true;
+        this->matched_prefix[empty_idx] = true;
+    }
+
+#ifdef JP
+    std::vector<bool> is_char_head(item_name.size());
+    for (size_t i = 0; i < item_name.size(); i++) {
+        is_char_head[i] = true;
+        if (iskanji(item_name[i])) {
+            i++;
+        }
+    }
+#endif
+
+    auto state = 0;
+    for (size_t i = 0; i < item_name.size(); i++) {
+        const auto c = item_name[i];
+        auto it = this->nodes[state].children.find(c);
+        while ((it == this->nodes[state].children.end()) && (state != 0)) {
+            state = this->nodes[state].fail;
+            it = this->nodes[state].children.find(c);
+        }
+
+        state = (it != this->nodes[state].children.end()) ? it->second : 0;
+        for (auto out = this->nodes[state].output; out >= 0; out = this->nodes[this->nodes[out].fail].output) {
+            const auto pattern_idx = this->nodes[out].pattern_idx;
+            const auto start = i + 1 - this->pattern_lengths[pattern_idx];
+#ifdef JP
+            if (!is_char_head[start]) {
+                continue;
+            }
+#endif
+            this->matched_anywhere[pattern_idx] = true;
+            if (start == 0) {
+                this->matched_prefix[pattern_idx] = true;
+            }
+        }
+    }
+}
+
+/*!
+ * @brief 直前の match_names() でエントリの名称条件が一致したかを返す
+ * @param entry_idx エントリ番号
+ * @return 一致していればtrue
+ */
+bool AutopickListIndex::is_name_matched(int entry_idx) const
+{
+    const auto pattern_idx = this->entry_patterns[entry_idx];
+    return this->entry_prefixes[entry_idx] ? this->matched_prefix[pattern_idx] : this->matched_anywhere[pattern_idx];
+}
+
+/*!
+ * @brief 索引が自動拾いリストと食い違っていれば作り直す
+ * @details invalidate() の呼び忘れに備え、エントリ数の変化も検出する
+ */
+void AutopickListIndex::update()
+{
+    if (this->is_built && (this->list_size == autopick_list.size())) {
+        return;
+    }
+
+    this->candidates.clear();
+    this->nodes.assign(1, Node{});
+    this->pattern_lengths.clear();
+    this->entry_patterns.clear();
+    this->entry_prefixes.clear();
+    for (const auto &entry : autopick_list) {
+        std::string_view name(entry.name);
+        const auto is_prefix = name.starts_with('^');
+        if (is_prefix) {
+            name.remove_prefix(1);
+        }
+
+        this->entry_patterns.push_back(this->add_pattern(name));
+        this->entry_prefixes.push_back(is_prefix);
+    }
+
+    std::deque<int> queue;
+    for (const auto &[c, child] : this->nodes[0].children) {
+        queue.push_back(child);
+    }
+
+    while (!queue.empty()) {
+        const auto node_idx = queue.front();
+        queue.pop_front();
+        auto &node = this->nodes[node_idx];
+        node.output = (node.pattern_idx >= 0) ? node_idx : this->nodes[node.fail].output;
+        for (const auto &[c, child] : node.children) {
+            auto fail = node.fail;
+            auto it = this->nodes[fail].children.find(c);
+            while ((it == this->nodes[fail].children.end()) && (fail != 0)) {
+                fail = this->nodes[fail].fail;
+                it = this->nodes[fail].children.find(c);
+            }
+
+            this->nodes[child].fail = (it != this->nodes[fail].children.end()) ? it->second : 0;
+            queue.push_back(child);
+        }
+    }
+
+    this->is_built = true;
+    this->list_size = autopick_list.size();
+}
+
+/*!
+ * @brief 名称をオートマトンに登録する
+ * @param pattern 名称
+ * @return 名称番号. 登録済の名称ならその番号
+ */
+int AutopickListIndex::add_pattern(std::string_view pattern)
+{
+    auto node_idx = 0;
+    for (const auto c : pattern) {
+        const auto it = this->nodes[node_idx].children.find(c);
+        if (it != this->nodes[node_idx].children.end()) {
+            node_idx = it->second;
+            continue;
+        }
+
+        const auto child = static_cast<int>(this->nodes.size());
+        this->nodes[node_idx].children.emplace(c, child);
+        this->nodes.emplace_back();
+        node_idx = child;
+    }
+
+    auto &node = this->nodes[node_idx];
+    if (node.pattern_idx < 0) {
+        node.pattern_idx = static_cast<int>(this->pattern_lengths.size());
+        this->pattern_lengths.push_back(static_cast<int>(pattern.size()));
+    }
+
+    return node.pattern_idx;
+}
@@ -0,0 +1,61 @@
+﻿#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ItemKindType : short;
+
+/*!
+ * @brief 自動拾いリストの検索索引
+ * @details
+ * 各エントリをアイテム種別 (tval) の前提条件で振り分けた候補リストと、
+ * 全エントリの名称条件をまとめた Aho-Corasick オートマトンを保持する.
+ * これにより、アイテム名の走査1回で全エントリの名称条件を判定し、
+ * 種別・名称のいずれかが一致し得ないエントリを is_autopick_match() を呼ばずに読み飛ばす.
+ * 自動拾いリストを変更した時は invalidate() を呼ぶこと.
+ */
+class AutopickListIndex {
+public:
+    AutopickListIndex(const AutopickListIndex &) = delete;
+    AutopickListIndex(AutopickListIndex &&) = delete;
+    AutopickListIndex &operator=(const AutopickListIndex &) = delete;
+    AutopickListIndex &operator=(AutopickListIndex &&) = delete;
+    ~AutopickListIndex() = default;
+
+    static AutopickListIndex &get_instance();
+
+    void invalidate();
+    const std::vector<int> &get_candidates(ItemKindType tval);
+    void match_names(std::string_view item_name);
+    bool is_name_matched(int entry_idx) const;
+
+private:
+    AutopickListIndex() = default;
+
+    static AutopickListIndex instance;
+
+    /*!
+     * @brief オートマトンの節点
+     */
+    struct Node {
+        std::map<char, int> children{}; //!< 子節点
+        int fail = 0; //!< 失敗時の遷移先
+        int output = -1; //!< 失敗遷移を辿って最初に見つかる、名称が終端する節点 (自身を含む)
+        int pattern_idx = -1; //!< この節点で終端する名称の番号
+    };
+
+    bool is_built = false;
+    size_t list_size = 0;
+    std::map<ItemKindType, std::vector<int>> candidates{}; //!< tval毎の候補エントリ番号 (リストの順)
+    std::vector<Node> nodes{};
+    std::vector<int> pattern_lengths{}; //!< 名称毎の長さ
+    std::vector<int> entry_patterns{}; //!< エントリ毎の名称番号
+    std::vector<bool> entry_prefixes{}; //!< エントリ毎の前方一致指定
+    std::vector<bool> matched_anywhere{}; //!< 名称毎の一致結果
+    std::vector<bool> matched_prefix{}; //!< 名称毎の前方一致結果
+
+    void update();
+    int add_pattern(std::string_view pattern);
+};
@@ -7,6 +7,7 @@
 #include "autopick/autopick-registry.h"
 #include "autopick/autopick-entry.h"
 #include "autopick/autopick-finder.h"
+#include "autopick/autopick-list-index.h"
 #include "autopick/autopick-methods-table.h"
 #include "autopick/autopick-reader-writer.h"
 #include "autopick/autopick-util.h"
@@ -189,6 +190,7 @@ bool autopick_autoregister(PlayerType *player_ptr, ItemEntity *o_ptr)
     autopick_entry_from_object(player_ptr, entry, o_ptr);
     entry->action = DO_AUTODESTROY;
     autopick_list.push_back(*entry);
+    AutopickListIndex::get_instance().invalidate();
 
     concptr tmp = autopick_line_from_entry(*entry);
     fprintf(pref_fff, "%s\n", tmp);
@@ -78,7 +78,6 @@ void do_cmd_pet_dismiss(PlayerType *player_ptr)
     bool all_pets = false;
     int Dismissed = 0;
 
-    uint16_t dummy_why;
     bool cu, cv;
 
     cu = game_term->scr->cu;
@@ -97,7 +96,7 @@ void do_cmd_pet_dismiss(PlayerType *player_ptr)
         }
     }
 
-    ang_sort(player_ptr, who.data(), &dummy_why, who.size(), ang_sort_comp_pet_dismiss, ang_sort_swap_hook);
+    sort_pet_indices_to_dismiss(player_ptr, who);
 
     /* Process the monsters (backwards) */
     auto &rfu = RedrawingFlagsUpdater::get_instance();
@@ -819,7 +818,7 @@ void do_cmd_pet(PlayerType *player_ptr)
             player_ptr->pet_extra_flags |= (PF_TWO_HANDS);
         }
 
-        RedrawingFlagsUpdater::get_instance().set_flag(StatusRecalculatingFlag::BONUS);
+        RedrawingFlagsUpdater::get_instance().set_flag(StatusRecalculatingFlag::BONUS_RIDING);
         handle_stuff(player_ptr);
         break;
     }
@@ -155,7 +155,7 @@ void do_cmd_query_symbol(PlayerType *player_ptr)
     query = inkey();
     prt(buf, 0, 0);
     why = 2;
-    ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    sort_monrace_ids(who, why);
     if (query == 'k') {
         why = 4;
         query = 'y';
@@ -166,7 +166,7 @@ void do_cmd_query_symbol(PlayerType *player_ptr)
     }
 
     if (why == 4) {
-        ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+        sort_monrace_ids(who, why);
     }
 
     auto i = who.size() - 1;
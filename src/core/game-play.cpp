@@ -39,12 +39,14 @@
 #include "game-option/runtime-arguments.h"
 #include "grid/feature.h"
 #include "grid/grid.h"
+#include "grid/lite-spot-queue.h"
 #include "info-reader/fixed-map-parser.h"
 #include "io/files-util.h"
 #include "io/input-key-acceptor.h"
 #include "io/input-key-processor.h"
 #include "io/read-pref-file.h"
 #include "io/record-play-movie.h"
+#include "io/score-upload-queue.h"
 #include "io/screen-util.h"
 #include "io/signal-handlers.h"
 #include "io/write-diary.h"
@@ -103,6 +105,7 @@ static void restore_windows(PlayerType *player_ptr)
     w_ptr->character_icky_depth = 1;
     term_activate(angband_terms[0]);
     angband_terms[0]->resize_hook = resize_map;
+    angband_terms[0]->delayed_draw_hook = [] { LiteSpotQueue::get_instance().flush(); };
     for (auto i = 1U; i < angband_terms.size(); ++i) {
         if (angband_terms[i]) {
             angband_terms[i]->resize_hook = redraw_window;
@@ -416,6 +419,9 @@ void play_game(PlayerType *player_ptr, bool new_game, bool browsing_movie)
     }
 
     extract_option_vars();
+#ifdef WORLD_SCORE
+    ScoreUploadQueue::get_instance().start();
+#endif
     send_waiting_record(player_ptr);
     w_ptr->creating_savefile = new_game;
     init_random_seed(player_ptr, new_game);
@@ -448,5 +454,6 @@ void play_game(PlayerType *player_ptr, bool new_game, bool browsing_movie)
     select_floor_music(player_ptr);
     process_game_turn(player_ptr);
     close_game(player_ptr);
+    stop_movie_recording();
     quit(nullptr);
 }
@@ -33,6 +33,12 @@ static void compact_objects_aux(FloorType *floor_ptr, OBJECT_IDX i1, OBJECT_IDX
     // 要素番号i1のオブジェクトを要素番号i2に移動
     floor_ptr->o_list[i2] = floor_ptr->o_list[i1];
     o_ptr->wipe();
+    floor_ptr->live_object_indices.reset(i1);
+    floor_ptr->live_object_indices.set(i2);
+    floor_ptr->found_item_index.remove(i1);
+    if (floor_ptr->o_list[i2].marked.has(OmType::FOUND)) {
+        floor_ptr->found_item_index.add(i2);
+    }
 }
 
 /*!
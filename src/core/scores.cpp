@@ -166,7 +166,7 @@ bool send_world_score(PlayerType *player_ptr, bool do_send)
         return false;
     }
 
-    prt(_("完了。何かキーを押してください。", "Completed.  Hit any key."), 0, 0);
+    prt(_("バックグラウンドで送信します。何かキーを押してください。", "The score will be sent in the background.  Hit any key."), 0, 0);
     (void)inkey();
 #else
     (void)player_ptr;
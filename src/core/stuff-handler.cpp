@@ -1,5 +1,6 @@
 ﻿#include "core/stuff-handler.h"
 #include "core/window-redrawer.h"
+#include "flavor/flavor-describer.h"
 #include "player/player-status.h"
 #include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
@@ -14,6 +15,7 @@ void handle_stuff(PlayerType *player_ptr)
         update_creature(player_ptr);
     }
 
+    ItemDescriptionCacheScope description_cache_scope;
     if (rfu.any_main()) {
         redraw_stuff(player_ptr);
     }
@@ -226,38 +226,35 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX who, POSITION ra
             breath_shape(player_ptr, path_g, path_n, &grids, gx, gy, gm, &gm_rad, rad, y1, x1, by, bx, typ);
         } else {
             for (auto dist = 0; dist <= rad; dist++) {
-                for (auto y = by - dist; y <= by + dist; y++) {
-                    for (auto x = bx - dist; x <= bx + dist; x++) {
-                        if (!in_bounds2(player_ptr->current_floor_ptr, y, x)) {
+                for (const auto &offset : get_ring_offsets(dist)) {
+                    const auto y = by + offset.y;
+                    const auto x = bx + offset.x;
+                    if (!in_bounds2(player_ptr->current_floor_ptr, y, x)) {
+                        continue;
+                    }
+
+                    switch (typ) {
+                    case AttributeType::LITE:
+                    case AttributeType::LITE_WEAK:
+                        if (!los(player_ptr, by, bx, y, x)) {
                             continue;
                         }
-                        if (distance(by, bx, y, x) != dist) {
+                        break;
+                    case AttributeType::DISINTEGRATE:
+                        if (!in_disintegration_range(player_ptr->current_floor_ptr, by, bx, y, x)) {
                             continue;
                         }
-
-                        switch (typ) {
-                        case AttributeType::LITE:
-                        case AttributeType::LITE_WEAK:
-                            if (!los(player_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
-                        case AttributeType::DISINTEGRATE:
-                            if (!in_disintegration_range(player_ptr->current_floor_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
-                        default:
-                            if (!projectable(player_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
+                        break;
+                    default:
+                        if (!projectable(player_ptr, by, bx, y, x)) {
+                            continue;
                         }
-
-                        gy[grids] = y;
-                        gx[grids] = x;
-                        grids++;
+                        break;
                     }
+
+                    gy[grids] = y;
+                    gx[grids] = x;
+                    grids++;
                 }
 
                 gm[dist + 1] = grids;
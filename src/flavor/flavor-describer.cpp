@@ -570,13 +570,13 @@ static describe_option_type decide_describe_option(const ItemEntity &item, BIT_F
 }
 
 /*!
- * @brief オブジェクトの各表記を返す
+ * @brief オブジェクトの各表記を組み立てる
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param o_ptr 特性短縮表記を得たいオブジェクト構造体の参照ポインタ
  * @param mode 表記に関するオプション指定
  * @return modeに応じたオブジェクトの表記
  */
-std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
+static std::string build_flavor_description(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
 {
     const auto &item = *o_ptr;
     const auto opt = decide_describe_option(item, mode);
@@ -614,3 +614,75 @@ std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT
     ss << describe_inscription(item, opt);
     return str_substr(ss.str(), 0, max_length);
 }
+
+/*!
+ * @brief オブジェクトの各表記を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr 特性短縮表記を得たいオブジェクト構造体の参照ポインタ
+ * @param mode 表記に関するオプション指定
+ * @return modeに応じたオブジェクトの表記
+ * @details ItemDescriptionCacheScope の区間内では、同じ表記オプションで作成済の名称を再利用する
+ */
+std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
+{
+    if (ItemDescriptionCacheScope::get_generation() == 0) {
+        return build_flavor_description(player_ptr, o_ptr, mode, max_length);
+    }
+
+    return describe_flavor_cached(player_ptr, o_ptr, mode, max_length);
+}
+
+/*!
+ * @brief オブジェクトの各表記をキャッシュへの参照で返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr 特性短縮表記を得たいオブジェクト構造体の参照ポインタ
+ * @param mode 表記に関するオプション指定
+ * @return modeに応じたオブジェクトの表記
+ * @details 再描画処理向けに、キャッシュが有効なら文字列を複製せずに返す.
+ * ItemDescriptionCacheScope の区間外では毎回作り直す.
+ * 戻り値は同じアイテムに対して次に describe_flavor() / describe_flavor_cached() を呼ぶまで有効.
+ */
+const std::string &describe_flavor_cached(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
+{
+    const auto generation = ItemDescriptionCacheScope::get_generation();
+    auto &cache = o_ptr->description_cache;
+    if ((generation == 0) || (cache.generation != generation) || (cache.mode != mode) || (cache.max_length != max_length)) {
+        cache.name = build_flavor_description(player_ptr, o_ptr, mode, max_length);
+        cache.generation = generation;
+        cache.mode = mode;
+        cache.max_length = max_length;
+    }
+
+    return cache.name;
+}
+
+int ItemDescriptionCacheScope::depth = 0;
+uint32_t ItemDescriptionCacheScope::generation = 0;
+
+/*!
+ * @brief 区間に入り、世代番号を進める
+ * @details 入れ子の区間でも世代番号を進める.
+ * 再描画中のウィンドウサイズ変更などで内側の区間の直前にプレイヤーの状態が再計算されても、
+ * 外側の区間で作成したキャッシュを使わないようにするため.
+ */
+ItemDescriptionCacheScope::ItemDescriptionCacheScope()
+{
+    depth++;
+    if (++generation == 0) {
+        generation = 1;
+    }
+}
+
+ItemDescriptionCacheScope::~ItemDescriptionCacheScope()
+{
+    depth--;
+}
+
+/*!
+ * @brief 現在有効なキャッシュの世代番号を返す
+ * @return 世代番号. 区間外なら0
+ */
+uint32_t ItemDescriptionCacheScope::get_generation()
+{
+    return (depth > 0) ? generation : 0;
+}
@@ -1,8 +1,33 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include <cstdint>
+#include <string>
 #include <string_view>
 
 class ItemEntity;
 class PlayerType;
 std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, const BIT_FLAGS mode, const size_t max_length = std::string_view::npos);
+const std::string &describe_flavor_cached(PlayerType *player_ptr, const ItemEntity *o_ptr, const BIT_FLAGS mode, const size_t max_length = std::string_view::npos);
+
+/*!
+ * @brief describe_flavor() の結果をキャッシュする区間
+ * @details 画面の再描画中はアイテムもプレイヤーも変化しないため、
+ * この区間の間は同じアイテムの名称を作り直さずに済ませる.
+ * 区間に入る度に世代番号を進め、それより前のキャッシュを無効にする.
+ */
+class ItemDescriptionCacheScope {
+public:
+    ItemDescriptionCacheScope();
+    ItemDescriptionCacheScope(const ItemDescriptionCacheScope &) = delete;
+    ItemDescriptionCacheScope(ItemDescriptionCacheScope &&) = delete;
+    ItemDescriptionCacheScope &operator=(const ItemDescriptionCacheScope &) = delete;
+    ItemDescriptionCacheScope &operator=(ItemDescriptionCacheScope &&) = delete;
+    ~ItemDescriptionCacheScope();
+
+    static uint32_t get_generation();
+
+private:
+    static int depth;
+    static uint32_t generation;
+};
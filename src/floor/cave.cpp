@@ -73,7 +73,7 @@ bool is_cave_empty_bold2(PlayerType *player_ptr, POSITION y, POSITION x)
 
 bool cave_has_flag_bold(FloorType *floor_ptr, POSITION y, POSITION x, TerrainCharacteristics f_idx)
 {
-    return terrains_info[floor_ptr->grid_array[y][x].feat].flags.has(f_idx);
+    return terrains_info[floor_ptr->get_grid({ y, x }).feat].flags.has(f_idx);
 }
 
 /*
@@ -81,7 +81,7 @@ bool cave_has_flag_bold(FloorType *floor_ptr, POSITION y, POSITION x, TerrainCha
  */
 bool player_has_los_bold(PlayerType *player_ptr, POSITION y, POSITION x)
 {
-    return ((player_ptr->current_floor_ptr->grid_array[y][x].info & CAVE_VIEW) != 0) || player_ptr->phase_out;
+    return ((player_ptr->current_floor_ptr->get_grid({ y, x }).info & CAVE_VIEW) != 0) || player_ptr->phase_out;
 }
 
 /*
@@ -109,7 +109,7 @@ bool cave_stop_disintegration(FloorType *floor_ptr, POSITION y, POSITION x)
  */
 bool cave_los_bold(FloorType *floor_ptr, POSITION y, POSITION x)
 {
-    return feat_supports_los(floor_ptr->grid_array[y][x].feat);
+    return feat_supports_los(floor_ptr->get_grid({ y, x }).feat);
 }
 
 /*
@@ -218,6 +218,7 @@ static void check_visited_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr
 
     if (player_ptr->change_floor_mode & (CFM_DOWN | CFM_UP)) {
         g_ptr->feat = rand_choice(feat_ground_type);
+        player_ptr->current_floor_ptr->terrain_generation++;
     }
 
     g_ptr->special = 0;
@@ -354,6 +355,7 @@ static void update_new_floor_feature(PlayerType *player_ptr, saved_floor_type *s
     }
 
     g_ptr->mimic = 0;
+    floor.terrain_generation++;
     g_ptr->special = player_ptr->floor_id;
 }
 
@@ -364,6 +364,9 @@ void clear_cave(PlayerType *player_ptr)
     std::fill_n(floor_ptr->o_list.begin(), floor_ptr->o_max, ItemEntity{});
     floor_ptr->o_max = 1;
     floor_ptr->o_cnt = 0;
+    floor_ptr->live_object_indices.clear();
+    floor_ptr->found_item_index.clear();
+    floor_ptr->terrain_generation++;
 
     for (auto &[r_idx, r_ref] : monraces_info) {
         r_ref.cur_num = 0;
@@ -372,6 +375,7 @@ void clear_cave(PlayerType *player_ptr)
     std::fill_n(floor_ptr->m_list.begin(), floor_ptr->m_max, MonsterEntity{});
     floor_ptr->m_max = 1;
     floor_ptr->m_cnt = 0;
+    floor_ptr->live_monster_indices.clear();
     for (int i = 0; i < MAX_MTIMED; i++) {
         floor_ptr->mproc_max[i] = 0;
     }
@@ -551,6 +555,8 @@ void generate_floor(PlayerType *player_ptr)
         wipe_monsters_list(player_ptr);
     }
 
+    // 生成中は地形を直接書き換えるため、生成後に改めて視線・射線判定のキャッシュを破棄させる
+    floor_ptr->terrain_generation++;
     glow_deep_lava_and_bldg(player_ptr);
     player_ptr->enter_dungeon = false;
     wipe_generate_random_floor_flags(floor_ptr);
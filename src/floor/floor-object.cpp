@@ -204,6 +204,8 @@ void delete_all_items_from_floor(PlayerType *player_ptr, POSITION y, POSITION x)
         o_ptr = &floor_ptr->o_list[this_o_idx];
         o_ptr->wipe();
         floor_ptr->o_cnt--;
+        floor_ptr->live_object_indices.reset(this_o_idx);
+        floor_ptr->found_item_index.remove(this_o_idx);
     }
 
     g_ptr->o_idx_list.clear();
@@ -285,6 +287,8 @@ void delete_object_idx(PlayerType *player_ptr, OBJECT_IDX o_idx)
 
     j_ptr->wipe();
     floor_ptr->o_cnt--;
+    floor_ptr->live_object_indices.reset(o_idx);
+    floor_ptr->found_item_index.remove(o_idx);
     static constexpr auto flags = {
         SubWindowRedrawingFlag::FLOOR_ITEMS,
         SubWindowRedrawingFlag::FOUND_ITEMS,
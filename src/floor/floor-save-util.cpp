@@ -1,4 +1,5 @@
 ﻿#include "floor/floor-save-util.h"
+#include "util/lz-codec.h"
 
 /*
  * Sign for current process used in temporary files.
@@ -6,7 +7,71 @@
  */
 uint32_t saved_floor_file_sign;
 saved_floor_type saved_floors[MAX_SAVED_FLOORS];
+std::array<SavedFloorImage, MAX_SAVED_FLOORS> saved_floor_images; /*!< 保存フロアのデータ. savefile_id 毎に保持する */
 FLOOR_IDX max_floor_id; /*!< Number of floor_id used from birth */
 FLOOR_IDX new_floor_id; /*!<次のフロアのID / floor_id of the destination */
 uint32_t latest_visit_mark; /*!<フロアを渡った回数？(確認中) / Max number of visit_mark */
 MonsterEntity party_mon[MAX_PARTY_MON]; /*!< フロア移動に保存するペットモンスターの配列 */
+
+/*!
+ * @brief データを保持しているかを返す
+ * @return 保持していなければtrue
+ */
+bool SavedFloorImage::empty() const
+{
+    return this->raw_size == 0;
+}
+
+/*!
+ * @brief 保持しているデータを破棄する
+ */
+void SavedFloorImage::clear()
+{
+    this->compressed.clear();
+    this->compressed.shrink_to_fit();
+    this->raw_size = 0;
+}
+
+/*!
+ * @brief データを圧縮して保持する
+ * @param bytes 保持するデータ
+ * @details セーブファイルの書式は直前のバイトとの排他的論理和で符号化されており、そのままでは繰り返しが現れにくい.
+ * そのため直前のバイトとの排他的論理和を取って符号化を打ち消してから圧縮する.
+ */
+void SavedFloorImage::store(const std::vector<byte> &bytes)
+{
+    std::string raw(bytes.size(), '\0');
+    byte prev = 0;
+    for (size_t i = 0; i < bytes.size(); i++) {
+        raw[i] = static_cast<char>(bytes[i] ^ prev);
+        prev = bytes[i];
+    }
+
+    this->compressed = lz_compress(raw);
+    this->raw_size = bytes.size();
+}
+
+/*!
+ * @brief 保持しているデータを伸張して返す
+ * @return 伸張したデータ. 保持していないか壊れていればstd::nullopt
+ */
+std::optional<std::vector<byte>> SavedFloorImage::restore() const
+{
+    if (this->empty()) {
+        return std::nullopt;
+    }
+
+    const auto raw = lz_decompress(this->compressed, this->raw_size);
+    if (!raw) {
+        return std::nullopt;
+    }
+
+    std::vector<byte> bytes(raw->length());
+    byte prev = 0;
+    for (size_t i = 0; i < bytes.size(); i++) {
+        prev ^= static_cast<byte>((*raw)[i]);
+        bytes[i] = prev;
+    }
+
+    return bytes;
+}
@@ -2,6 +2,10 @@
 
 #include "system/angband.h"
 #include "system/monster-entity.h"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
 
 #define MAX_SAVED_FLOORS 20 /*!< 保存フロアの最大数 / Maximum number of saved floors. */
 #define MAX_PARTY_MON 21 /*!< フロア移動時に先のフロアに連れて行けるペットの最大数 Maximum number of preservable pets */
@@ -16,8 +20,23 @@ struct saved_floor_type {
     FLOOR_IDX lower_floor_id; /* a floor connected with level tel. and trap door */
 };
 
+/*!
+ * @brief 保存フロアのデータ
+ * @details 一時ファイルに書き込んでいた内容を圧縮して保持する
+ */
+struct SavedFloorImage {
+    std::string compressed; /*!< 圧縮したデータ */
+    size_t raw_size = 0; /*!< 伸張後の長さ */
+
+    bool empty() const;
+    void clear();
+    void store(const std::vector<byte> &bytes);
+    std::optional<std::vector<byte>> restore() const;
+};
+
 extern uint32_t saved_floor_file_sign;
 extern saved_floor_type saved_floors[MAX_SAVED_FLOORS];
+extern std::array<SavedFloorImage, MAX_SAVED_FLOORS> saved_floor_images;
 extern FLOOR_IDX max_floor_id;
 
 extern FLOOR_IDX new_floor_id;
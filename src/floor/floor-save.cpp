@@ -24,6 +24,13 @@
 #include "term/z-form.h"
 #include "util/angband-files.h"
 #include "view/display-messages.h"
+#include <cstdlib>
+#include <filesystem>
+
+/*!
+ * @brief 取得中のロックファイルのパス. 取得していなければ空
+ */
+static std::filesystem::path saved_floor_lock_path;
 
 static std::string get_saved_floor_name(int level)
 {
@@ -54,28 +61,83 @@ static void check_saved_tmp_files(const int fd, bool *force)
     *force = true;
 }
 
+/*!
+ * @brief セーブファイルのロックファイルを削除する
+ */
+static void unlock_saved_floors()
+{
+    if (saved_floor_lock_path.empty()) {
+        return;
+    }
+
+    safe_setuid_grab();
+    fd_kill(saved_floor_lock_path);
+    safe_setuid_drop();
+    saved_floor_lock_path.clear();
+}
+
+/*!
+ * @brief セーブファイルのロックファイルを作る
+ * @param force ロックファイルが残っていた場合も警告なしで強制的に作り直すフラグ
+ * @details
+ * 保存フロアはメモリ上に保持するためプレイ中に一時ファイルは存在しない.
+ * 代わりにプロセスの終了まで残るロックファイルを作り、同じセーブファイルでの二重起動を検出する.
+ */
+static void lock_saved_floors(bool force)
+{
+    if (!saved_floor_lock_path.empty()) {
+        return;
+    }
+
+    const auto path = savefile.string().append(".lck");
+    safe_setuid_grab();
+    auto fd = fd_make(path);
+    safe_setuid_drop();
+    if (fd < 0) {
+        check_saved_tmp_files(fd, &force);
+        safe_setuid_grab();
+        fd_kill(path);
+        fd = fd_make(path);
+        safe_setuid_drop();
+    }
+
+    if (fd < 0) {
+        return;
+    }
+
+    (void)fd_close(fd);
+    saved_floor_lock_path = path;
+    static auto is_registered = false;
+    if (!is_registered) {
+        std::atexit(unlock_saved_floors);
+        is_registered = true;
+    }
+}
+
 /*!
  * @brief 保存フロア配列を初期化する / Initialize saved_floors array.
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param force テンポラリファイルが残っていた場合も警告なしで強制的に削除するフラグ
  * @details Make sure that old temporary files are not remaining as gurbages.
+ * 旧版が作った一時ファイルは、旧版が同じセーブファイルで実行中の可能性があるため同様に確認する.
  */
 void init_saved_floors(PlayerType *player_ptr, bool force)
 {
-    auto fd = -1;
     for (int i = 0; i < MAX_SAVED_FLOORS; i++) {
         saved_floor_type *sf_ptr = &saved_floors[i];
         auto floor_savefile = get_saved_floor_name(i);
         safe_setuid_grab();
-        fd = fd_make(floor_savefile);
+        auto fd = fd_make(floor_savefile);
         safe_setuid_drop();
         check_saved_tmp_files(fd, &force);
         safe_setuid_grab();
         (void)fd_kill(floor_savefile);
         safe_setuid_drop();
         sf_ptr->floor_id = 0;
+        saved_floor_images[i].clear();
     }
 
+    lock_saved_floors(force);
     max_floor_id = 1;
     latest_visit_mark = 1;
     saved_floor_file_sign = (uint32_t)time(nullptr);
@@ -84,8 +146,9 @@ void init_saved_floors(PlayerType *player_ptr, bool force)
 }
 
 /*!
- * @brief 保存フロア用テンポラリファイルを削除する / Kill temporary files
+ * @brief 保存フロアのデータを破棄する / Kill saved floor data
  * @details Should be called just before the game quit.
+ * 保存フロアはメモリ上に保持しているため、一時ファイルの代わりにロックファイルを削除する.
  * @param player_ptr プレイヤーへの参照ポインタ
  */
 void clear_saved_floor_files(PlayerType *player_ptr)
@@ -96,10 +159,10 @@ void clear_saved_floor_files(PlayerType *player_ptr)
             continue;
         }
 
-        safe_setuid_grab();
-        (void)fd_kill(get_saved_floor_name(i));
-        safe_setuid_drop();
+        saved_floor_images[i].clear();
     }
+
+    unlock_saved_floors();
 }
 
 /*!
@@ -140,9 +203,7 @@ void kill_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
         return;
     }
 
-    safe_setuid_grab();
-    (void)fd_kill(get_saved_floor_name((int)sf_ptr->savefile_id));
-    safe_setuid_drop();
+    saved_floor_images[sf_ptr->savefile_id].clear();
     sf_ptr->floor_id = 0;
 }
 
@@ -145,6 +145,8 @@ void wipe_o_list(FloorType *floor_ptr)
 
     floor_ptr->o_max = 1;
     floor_ptr->o_cnt = 0;
+    floor_ptr->live_object_indices.clear();
+    floor_ptr->found_item_index.clear();
 }
 
 /*
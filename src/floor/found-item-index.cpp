@@ -0,0 +1,164 @@
+﻿/*!
+ * @brief 発見済みアイテムの索引
+ */
+
+#include "floor/found-item-index.h"
+#include "object/object-mark-types.h"
+#include "object/tval-types.h"
+#include "player/player-realm.h"
+#include "system/floor-type-definition.h"
+#include "system/item-entity.h"
+#include "system/player-type-definition.h"
+#include "util/enum-converter.h"
+#include "util/object-sort.h"
+#include <algorithm>
+
+/*!
+ * @brief 発見済みアイテムの一覧に表示するアイテムかを返す
+ * @param item アイテムへの参照
+ * @return 表示するならtrue
+ */
+static bool is_item_to_display(const ItemEntity &item)
+{
+    return item.is_valid() && (item.number > 0) && item.marked.has(OmType::FOUND) && (item.bi_key.tval() != ItemKindType::GOLD);
+}
+
+/*!
+ * @brief 並び順と価格に影響するアイテムの状態を要約する
+ * @param item アイテムへの参照
+ * @return 状態の要約値
+ */
+static uint64_t calc_sort_key(const ItemEntity &item)
+{
+    uint64_t key = 14695981039346656037ULL;
+    const auto mix = [&key](int64_t value) {
+        key = (key ^ static_cast<uint64_t>(value)) * 1099511628211ULL;
+    };
+
+    mix(item.bi_id);
+    mix(item.is_aware());
+    mix(item.ident);
+    mix(item.discount);
+    mix(item.pval);
+    mix(item.to_h);
+    mix(item.to_d);
+    mix(item.to_a);
+    mix(item.ac);
+    mix(item.dd);
+    mix(item.ds);
+    mix(enum2i(item.ego_idx));
+    mix(enum2i(item.fixed_artifact_idx));
+    mix(item.randart_name.has_value());
+    mix(item.is_cursed());
+    mix(item.smith_hit);
+    mix(item.smith_damage);
+    mix(item.smith_effect ? enum2i(*item.smith_effect) + 1 : 0);
+    mix(item.smith_act_idx ? enum2i(*item.smith_act_idx) + 1 : 0);
+    return key;
+}
+
+/*!
+ * @brief 索引できるアイテムの添字の上限を設定する
+ * @param size アイテム配列の大きさ
+ */
+void FoundItemIndex::resize(int size)
+{
+    this->members.resize(size);
+}
+
+/*!
+ * @brief 索引を空にする
+ */
+void FoundItemIndex::clear()
+{
+    this->members.clear();
+    this->entries.clear();
+    this->sorted_indices.clear();
+    this->is_sorted = true;
+}
+
+/*!
+ * @brief 発見済みになった、または発見済みのまま配置されたアイテムを索引に加える
+ * @param o_idx アイテムの添字
+ */
+void FoundItemIndex::add(OBJECT_IDX o_idx)
+{
+    if (this->members.test(o_idx)) {
+        return;
+    }
+
+    this->members.set(o_idx);
+    this->entries.push_back({ o_idx, 0, 0, false });
+    this->is_sorted = false;
+}
+
+/*!
+ * @brief 削除または移動したアイテムを索引から除く
+ * @param o_idx アイテムの添字
+ */
+void FoundItemIndex::remove(OBJECT_IDX o_idx)
+{
+    if (!this->members.test(o_idx)) {
+        return;
+    }
+
+    this->members.reset(o_idx);
+    std::erase_if(this->entries, [o_idx](const Entry &entry) { return entry.o_idx == o_idx; });
+    std::erase(this->sorted_indices, o_idx);
+}
+
+/*!
+ * @brief 発見済みアイテムの添字を所持品一覧と同じ順に返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return アイテムの添字の一覧
+ * @details 一覧に表示しなくなったアイテムはここで索引から除く.
+ * 状態が変わったアイテムだけ価格を計算し直し、追加や変化があった時だけ並べ替える.
+ */
+const std::vector<OBJECT_IDX> &FoundItemIndex::get_sorted_indices(PlayerType *player_ptr)
+{
+    const auto &o_list = player_ptr->current_floor_ptr->o_list;
+    const auto realm_key = enum2i(get_realm1_book(player_ptr)) * 256 + enum2i(get_realm2_book(player_ptr));
+    if (this->realm_key != realm_key) {
+        this->realm_key = realm_key;
+        this->is_sorted = false;
+    }
+
+    const auto old_size = this->entries.size();
+    std::erase_if(this->entries, [this, &o_list](Entry &entry) {
+        const auto &item = o_list[entry.o_idx];
+        if (!is_item_to_display(item)) {
+            this->members.reset(entry.o_idx);
+            return true;
+        }
+
+        const auto sort_key = calc_sort_key(item);
+        if (entry.is_evaluated && (entry.sort_key == sort_key)) {
+            return false;
+        }
+
+        entry.sort_key = sort_key;
+        entry.price = item.get_price();
+        entry.is_evaluated = true;
+        this->is_sorted = false;
+        return false;
+    });
+
+    if (this->is_sorted && (this->entries.size() == old_size)) {
+        return this->sorted_indices;
+    }
+
+    if (!this->is_sorted) {
+        auto &mutable_o_list = player_ptr->current_floor_ptr->o_list;
+        std::sort(this->entries.begin(), this->entries.end(), [player_ptr, &mutable_o_list](const Entry &left, const Entry &right) {
+            return object_sort_comp(player_ptr, &mutable_o_list[left.o_idx], left.price, &mutable_o_list[right.o_idx], right.price);
+        });
+        this->is_sorted = true;
+    }
+
+    this->sorted_indices.clear();
+    for (const auto &entry : this->entries) {
+        this->sorted_indices.push_back(entry.o_idx);
+    }
+
+    return this->sorted_indices;
+}
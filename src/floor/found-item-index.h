@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include "util/index-bitset.h"
+#include <cstdint>
+#include <vector>
+
+class PlayerType;
+
+/*!
+ * @brief 発見済みアイテムの索引
+ * @details
+ * 発見済み (OmType::FOUND) のアイテムの添字を所持品一覧と同じ順に並べて保持する.
+ * アイテムの発見・配置・削除・移動時に更新し、一覧の再描画では並べ替え済の添字を辿るだけで済ませる.
+ * 並び順に影響するアイテムの状態 (鑑定状況や修正値など) は参照時に照合し、変わっていれば並べ替え直す.
+ */
+class FoundItemIndex {
+public:
+    FoundItemIndex() = default;
+
+    void resize(int size);
+    void clear();
+    void add(OBJECT_IDX o_idx);
+    void remove(OBJECT_IDX o_idx);
+    const std::vector<OBJECT_IDX> &get_sorted_indices(PlayerType *player_ptr);
+
+private:
+    /*!
+     * @brief 索引の要素
+     */
+    struct Entry {
+        OBJECT_IDX o_idx; //!< アイテムの添字
+        uint64_t sort_key; //!< 並び順に影響する状態の要約
+        int price; //!< 並べ替えに用いる価格
+        bool is_evaluated; //!< sort_key と price を計算済か否か
+    };
+
+    IndexBitset members; //!< 索引に含まれるアイテムの添字
+    std::vector<Entry> entries{}; //!< 並べ替え済の要素 (未評価の要素は末尾に追加される)
+    std::vector<OBJECT_IDX> sorted_indices{};
+    int realm_key = -1; //!< 並べ替えた時の魔法領域
+    bool is_sorted = true;
+};
@@ -0,0 +1,101 @@
+﻿/*!
+ * @brief 視線・射線判定結果のキャッシュ
+ */
+
+#include "floor/line-of-sight-cache.h"
+
+namespace {
+/*!
+ * @brief 保持する結果の上限数
+ * @details 地形が長く変わらないフロアで際限なく増えないよう、超えたら全て破棄する.
+ */
+constexpr size_t MAX_RESULTS = 65536;
+
+/*!
+ * @brief 判定条件からキーを作る
+ * @return キー. 座標や射程が 0～255 の範囲外ならキャッシュしないため std::nullopt
+ */
+std::optional<uint64_t> make_key(LineOfSightType type, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int range)
+{
+    const auto is_valid = [](int value) { return (value >= 0) && (value < 256); };
+    if (!is_valid(y1) || !is_valid(x1) || !is_valid(y2) || !is_valid(x2) || !is_valid(range)) {
+        return std::nullopt;
+    }
+
+    auto key = static_cast<uint64_t>(type);
+    key = (key << 8) | static_cast<uint64_t>(range);
+    key = (key << 8) | static_cast<uint64_t>(y1);
+    key = (key << 8) | static_cast<uint64_t>(x1);
+    key = (key << 8) | static_cast<uint64_t>(y2);
+    key = (key << 8) | static_cast<uint64_t>(x2);
+    return key;
+}
+}
+
+/*!
+ * @brief 判定結果を検索する
+ * @param generation 現在のフロアの地形変化世代
+ * @param type 判定の種別
+ * @param y1 始点のy座標
+ * @param x1 始点のx座標
+ * @param y2 終点のy座標
+ * @param x2 終点のx座標
+ * @param range 射程 (射線判定のみ)
+ * @return 判定結果. 未判定ならstd::nullopt
+ */
+std::optional<bool> LineOfSightCache::find(uint32_t generation, LineOfSightType type, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int range)
+{
+    if (this->generation != generation) {
+        this->results.clear();
+        this->generation = generation;
+    }
+
+    const auto key = make_key(type, y1, x1, y2, x2, range);
+    if (!key) {
+        return std::nullopt;
+    }
+
+    const auto it = this->results.find(*key);
+    if (it == this->results.end()) {
+        this->miss_count++;
+        return std::nullopt;
+    }
+
+    this->hit_count++;
+    return it->second;
+}
+
+/*!
+ * @brief 判定結果を登録する
+ * @param type 判定の種別
+ * @param y1 始点のy座標
+ * @param x1 始点のx座標
+ * @param y2 終点のy座標
+ * @param x2 終点のx座標
+ * @param range 射程 (射線判定のみ)
+ * @param result 判定結果
+ * @details 直前の find() と同じ地形変化世代で判定した結果を渡すこと.
+ */
+void LineOfSightCache::store(LineOfSightType type, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int range, bool result)
+{
+    const auto key = make_key(type, y1, x1, y2, x2, range);
+    if (!key) {
+        return;
+    }
+
+    if (this->results.size() >= MAX_RESULTS) {
+        this->results.clear();
+    }
+
+    this->results[*key] = result;
+}
+
+uint64_t LineOfSightCache::get_hit_count() const
+{
+    return this->hit_count;
+}
+
+uint64_t LineOfSightCache::get_miss_count() const
+{
+    return this->miss_count;
+}
@@ -0,0 +1,37 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+/*!
+ * @brief 視線・射線判定の種別
+ */
+enum class LineOfSightType {
+    LOS, //!< los() の判定
+    PROJECTABLE, //!< projectable() の判定
+};
+
+/*!
+ * @brief 視線・射線判定結果のキャッシュ
+ * @details
+ * los() と projectable() の結果を始点・終点の組 (射線判定は射程も含む) 毎に保持する.
+ * いずれの判定も地形にのみ依存するため、フロアの地形変化世代 (FloorType::terrain_generation) が
+ * 変わった時点で全ての結果を破棄する.
+ */
+class LineOfSightCache {
+public:
+    LineOfSightCache() = default;
+
+    std::optional<bool> find(uint32_t generation, LineOfSightType type, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int range = 0);
+    void store(LineOfSightType type, POSITION y1, POSITION x1, POSITION y2, POSITION x2, int range, bool result);
+    uint64_t get_hit_count() const;
+    uint64_t get_miss_count() const;
+
+private:
+    std::unordered_map<uint64_t, bool> results{};
+    uint32_t generation = 0; //!< 保持している結果を判定した時の地形変化世代
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+};
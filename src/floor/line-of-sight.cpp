@@ -1,10 +1,11 @@
 ﻿#include "floor/line-of-sight.h"
 #include "floor/cave.h"
+#include "floor/line-of-sight-cache.h"
 #include "system/floor-type-definition.h"
 #include "system/player-type-definition.h"
 
 /*!
- * @brief LOS(Line Of Sight / 視線が通っているか)の判定を行う。
+ * @brief LOS(Line Of Sight / 視線が通っているか)を経路を辿って判定する。
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param y1 始点のy座標
  * @param x1 始点のx座標
@@ -46,7 +47,7 @@
  *\n
  * Use the "update_view()" function to determine player line-of-sight.\n
  */
-bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+static bool calc_los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
     POSITION dy = y2 - y1;
     POSITION dx = x2 - x1;
@@ -211,3 +212,26 @@ bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION
 
     return true;
 }
+
+/*!
+ * @brief LOS(Line Of Sight / 視線が通っているか)の判定を行う。
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param y1 始点のy座標
+ * @param x1 始点のx座標
+ * @param y2 終点のy座標
+ * @param x2 終点のx座標
+ * @return LOSが通っているならTRUEを返す。
+ * @details 地形が変わるまではフロア毎のキャッシュに保持した結果を返す.
+ */
+bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    auto &floor = *player_ptr->current_floor_ptr;
+    auto &cache = floor.line_of_sight_cache;
+    if (const auto cached = cache.find(floor.terrain_generation, LineOfSightType::LOS, y1, x1, y2, x2)) {
+        return *cached;
+    }
+
+    const auto result = calc_los(player_ptr, y1, x1, y2, x2);
+    cache.store(LineOfSightType::LOS, y1, x1, y2, x2, 0, result);
+    return result;
+}
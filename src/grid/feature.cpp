@@ -206,6 +206,7 @@ void cave_set_feat(PlayerType *player_ptr, POSITION y, POSITION x, FEAT_IDX feat
     auto *g_ptr = &floor_ptr->grid_array[y][x];
     auto *f_ptr = &terrains_info[feat];
     const auto &dungeon = floor_ptr->get_dungeon_definition();
+    floor_ptr->terrain_generation++;
     if (!w_ptr->character_dungeon) {
         g_ptr->mimic = 0;
         g_ptr->feat = feat;
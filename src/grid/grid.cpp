@@ -29,6 +29,7 @@
 #include "game-option/special-options.h"
 #include "grid/feature-action-flags.h"
 #include "grid/feature.h"
+#include "grid/lite-spot-queue.h"
 #include "grid/object-placer.h"
 #include "grid/trap.h"
 #include "io/screen-util.h"
@@ -64,8 +65,10 @@
 #include "view/display-map.h"
 #include "view/display-messages.h"
 #include "window/main-window-util.h"
+#include "window/map-overview.h"
 #include "world/world.h"
-#include <queue>
+#include <algorithm>
+#include <vector>
 
 /*!
  * @brief 新規フロアに入りたてのプレイヤーをランダムな場所に配置する / Returns random co-ordinates for player/monster/object
@@ -361,6 +364,7 @@ void note_spot(PlayerType *player_ptr, POSITION y, POSITION x)
 
         /* Memorize objects */
         o_ptr->marked.set(OmType::FOUND);
+        player_ptr->current_floor_ptr->found_item_index.add(this_o_idx);
         RedrawingFlagsUpdater::get_instance().set_flag(SubWindowRedrawingFlag::FOUND_ITEMS);
     }
 
@@ -411,27 +415,13 @@ void note_spot(PlayerType *player_ptr, POSITION y, POSITION x)
  * Redraw (on the screen) a given MAP location
  *
  * This function should only be called on "legal" grids
+ * The grid is actually drawn before the main screen is next touched (see LiteSpotQueue)
  */
 void lite_spot(PlayerType *player_ptr, POSITION y, POSITION x)
 {
+    MapOverview::get_instance().set_dirty(y, x);
     if (panel_contains(y, x) && in_bounds2(player_ptr->current_floor_ptr, y, x)) {
-        TERM_COLOR a;
-        char c;
-        TERM_COLOR ta;
-        char tc;
-
-        map_info(player_ptr, y, x, &a, &c, &ta, &tc);
-        if (!use_graphics) {
-            if (w_ptr->timewalk_m_idx) {
-                a = TERM_DARK;
-            } else if (is_invuln(player_ptr) || player_ptr->timewalk) {
-                a = TERM_WHITE;
-            } else if (player_ptr->wraith_form) {
-                a = TERM_L_DARK;
-            }
-        }
-
-        term_queue_bigchar(panel_col_of(x), y - panel_row_prt, a, c, ta, tc);
+        LiteSpotQueue::get_instance().push(player_ptr, y, x);
         static constexpr auto flags = {
             SubWindowRedrawingFlag::OVERHEAD,
             SubWindowRedrawingFlag::DUNGEON,
@@ -654,6 +644,34 @@ void lite_spot(PlayerType *player_ptr, POSITION y, POSITION x)
 static POSITION flow_x = 0;
 static POSITION flow_y = 0;
 
+/*!
+ * @brief 敵のプレイヤーに対する移動道のりの最大値(この値以上は処理を打ち切る).
+ * @details 幅優先探索はこの距離で打ち切られるため、フローが書き込まれるのは
+ * 起点を中心とした (2 * monster_flow_depth + 1) 四方の範囲に限られる.
+ */
+constexpr auto monster_flow_depth = 32;
+
+/*!
+ * @brief フロー情報を書き込みうる範囲 (起点を中心とした正方形) のフロー情報を消去する
+ * @param floor フロアへの参照
+ * @param y_center 起点のY座標
+ * @param x_center 起点のX座標
+ */
+static void reset_flow_window(FloorType &floor, POSITION y_center, POSITION x_center)
+{
+    const auto y_min = std::max(y_center - monster_flow_depth, 0);
+    const auto y_max = std::min(y_center + monster_flow_depth, floor.height - 1);
+    const auto x_min = std::max(x_center - monster_flow_depth, 0);
+    const auto x_max = std::min(x_center + monster_flow_depth, floor.width - 1);
+    for (auto y = y_min; y <= y_max; y++) {
+        auto *row = floor.grid_array[y];
+        for (auto x = x_min; x <= x_max; x++) {
+            row[x].reset_costs();
+            row[x].reset_dists();
+        }
+    }
+}
+
 /*
  * Hack -- fill in the "cost" field of every grid that the player
  * can "reach" with the number of steps needed to reach that grid.
@@ -666,11 +684,13 @@ static POSITION flow_y = 0;
  *
  * We do not need a priority queue because the cost from grid
  * to grid is always "one" and we process them in order.
+ *
+ * 探索は monster_flow_depth で打ち切られるため、フロア全体ではなく
+ * 前回の起点と今回の起点それぞれの周囲の範囲だけを消去して再計算する.
+ * 探索用キューはターンを跨いで再利用し、毎回の確保を避ける.
  */
 void update_flow(PlayerType *player_ptr)
 {
-    POSITION x, y;
-    DIRECTION d;
     auto &floor = *player_ptr->current_floor_ptr;
 
     /* The last way-point is on the map */
@@ -681,45 +701,43 @@ void update_flow(PlayerType *player_ptr)
         }
     }
 
-    /* Erase all of the current flow information */
-    for (y = 0; y < floor.height; y++) {
-        for (x = 0; x < floor.width; x++) {
-            auto &grid = floor.grid_array[y][x];
-            grid.reset_costs();
-            grid.reset_dists();
-        }
-    }
+    /* Erase the flow information around the last and the current way-point */
+    reset_flow_window(floor, flow_y, flow_x);
+    reset_flow_window(floor, player_ptr->y, player_ptr->x);
 
     /* Save player position */
     flow_y = player_ptr->y;
     flow_x = player_ptr->x;
 
+    // 幅優先探索用のキュー. 先頭位置を添字で管理し、確保済みの領域を使い回す.
+    static std::vector<Pos2D> que;
     for (int i = 0; i < FLOW_MAX; i++) {
-        // 幅優先探索用のキュー。
-        std::queue<Pos2D> que;
-        que.emplace(player_ptr->y, player_ptr->x);
+        que.clear();
+        que.emplace_back(player_ptr->y, player_ptr->x);
 
         /* Now process the queue */
-        while (!que.empty()) {
-            // 参照で受けるとダングリング状態になるのでコピーする.
-            const auto [ty, tx] = que.front();
-            que.pop();
+        for (size_t head = 0; head < que.size(); head++) {
+            // 追加で再確保されるとダングリング状態になるのでコピーする.
+            const auto [ty, tx] = que[head];
+            const auto &grid_from = floor.grid_array[ty][tx];
+            const byte cost_from = grid_from.costs[i];
+            const byte dist_from = grid_from.dists[i];
 
             /* Add the "children" */
-            for (d = 0; d < 8; d++) {
-                byte m = player_ptr->current_floor_ptr->grid_array[ty][tx].costs[i] + 1;
-                byte n = player_ptr->current_floor_ptr->grid_array[ty][tx].dists[i] + 1;
+            for (auto d = 0; d < 8; d++) {
+                byte m = cost_from + 1;
+                byte n = dist_from + 1;
 
                 /* Child location */
-                y = ty + ddy_ddd[d];
-                x = tx + ddx_ddd[d];
+                const auto y = ty + ddy_ddd[d];
+                const auto x = tx + ddx_ddd[d];
 
                 /* Ignore player's grid */
                 if (player_bold(player_ptr, y, x)) {
                     continue;
                 }
 
-                auto *g_ptr = &player_ptr->current_floor_ptr->grid_array[y][x];
+                auto *g_ptr = &floor.grid_array[y][x];
 
                 if (is_closed_door(player_ptr, g_ptr->feat)) {
                     m += 3;
@@ -753,14 +771,12 @@ void update_flow(PlayerType *player_ptr)
                     g_ptr->dists[i] = n;
                 }
 
-                // 敵のプレイヤーに対する移動道のりの最大値(この値以上は処理を打ち切る).
-                constexpr auto monster_flow_depth = 32;
                 if (n == monster_flow_depth) {
                     continue;
                 }
 
                 /* Enqueue that entry */
-                que.emplace(y, x);
+                que.emplace_back(y, x);
             }
         }
     }
@@ -998,6 +1014,7 @@ bool player_can_enter(PlayerType *player_ptr, FEAT_IDX feature, BIT_FLAGS16 mode
 
 void place_grid(PlayerType *player_ptr, grid_type *g_ptr, grid_bold_type gb_type)
 {
+    player_ptr->current_floor_ptr->terrain_generation++;
     switch (gb_type) {
     case GB_FLOOR: {
         g_ptr->feat = rand_choice(feat_ground_type);
@@ -1100,6 +1117,7 @@ void place_bold(PlayerType *player_ptr, POSITION y, POSITION x, grid_bold_type g
 void set_cave_feat(FloorType *floor_ptr, POSITION y, POSITION x, FEAT_IDX feature_idx)
 {
     floor_ptr->grid_array[y][x].feat = feature_idx;
+    floor_ptr->terrain_generation++;
 }
 
 /*!
@@ -0,0 +1,106 @@
+﻿/*!
+ * @brief マップの再描画の保留と一括描画
+ */
+
+#include "grid/lite-spot-queue.h"
+#include "floor/cave.h"
+#include "floor/floor-base-definitions.h"
+#include "game-option/special-options.h"
+#include "io/screen-util.h"
+#include "player/player-status.h"
+#include "system/floor-type-definition.h"
+#include "system/player-type-definition.h"
+#include "term/term-color-types.h"
+#include "term/z-term.h"
+#include "view/display-map.h"
+#include "window/main-window-util.h"
+#include "world/world.h"
+
+LiteSpotQueue LiteSpotQueue::instance{};
+
+LiteSpotQueue &LiteSpotQueue::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief グリッドの再描画を保留する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param y 再描画するグリッドのY座標
+ * @param x 再描画するグリッドのX座標
+ */
+void LiteSpotQueue::push(PlayerType *player_ptr, POSITION y, POSITION x)
+{
+    if ((y < 0) || (y >= MAX_HGT) || (x < 0) || (x >= MAX_WID)) {
+        return;
+    }
+
+    if (this->is_queued.empty()) {
+        this->is_queued.assign(MAX_HGT * MAX_WID, false);
+    }
+
+    this->player_ptr = player_ptr;
+    const auto index = y * MAX_WID + x;
+    if (this->is_queued[index]) {
+        return;
+    }
+
+    this->is_queued[index] = true;
+    this->queued_grids.emplace_back(y, x);
+}
+
+/*!
+ * @brief 保留しているグリッドを全て描画する
+ * @details 描画の時点でパネル外や階の外にあるグリッドは無視する.
+ * 描画中に z-term から再び呼ばれても何もしない.
+ */
+void LiteSpotQueue::flush()
+{
+    if (this->queued_grids.empty()) {
+        return;
+    }
+
+    this->drawing_grids.swap(this->queued_grids);
+    for (const auto &pos : this->drawing_grids) {
+        this->is_queued[pos.y * MAX_WID + pos.x] = false;
+    }
+
+    auto *floor_ptr = this->player_ptr->current_floor_ptr;
+    for (const auto &pos : this->drawing_grids) {
+        if (!panel_contains(pos.y, pos.x) || !in_bounds2(floor_ptr, pos.y, pos.x)) {
+            continue;
+        }
+
+        TERM_COLOR a;
+        char c;
+        TERM_COLOR ta;
+        char tc;
+        map_info(this->player_ptr, pos.y, pos.x, &a, &c, &ta, &tc);
+        if (!use_graphics) {
+            if (w_ptr->timewalk_m_idx) {
+                a = TERM_DARK;
+            } else if (is_invuln(this->player_ptr) || this->player_ptr->timewalk) {
+                a = TERM_WHITE;
+            } else if (this->player_ptr->wraith_form) {
+                a = TERM_L_DARK;
+            }
+        }
+
+        term_queue_bigchar(panel_col_of(pos.x), pos.y - panel_row_prt, a, c, ta, tc);
+    }
+
+    this->drawing_grids.clear();
+}
+
+/*!
+ * @brief 保留しているグリッドを描画せずに破棄する
+ * @details マップ全体を描き直す時に呼ぶ
+ */
+void LiteSpotQueue::clear()
+{
+    for (const auto &pos : this->queued_grids) {
+        this->is_queued[pos.y * MAX_WID + pos.x] = false;
+    }
+
+    this->queued_grids.clear();
+}
@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include "util/point-2d.h"
+#include <vector>
+
+class PlayerType;
+
+/*!
+ * @brief 再描画を保留しているマップのグリッド
+ * @details
+ * lite_spot() で再描画を要求されたグリッドを記録しておき、メイン画面へ次に書き込む前
+ * (term_fresh() 等) にまとめて描画する. 何度要求されたグリッドも描画は1回だけで済む.
+ */
+class LiteSpotQueue {
+public:
+    LiteSpotQueue(const LiteSpotQueue &) = delete;
+    LiteSpotQueue(LiteSpotQueue &&) = delete;
+    LiteSpotQueue &operator=(const LiteSpotQueue &) = delete;
+    LiteSpotQueue &operator=(LiteSpotQueue &&) = delete;
+    ~LiteSpotQueue() = default;
+
+    static LiteSpotQueue &get_instance();
+
+    void push(PlayerType *player_ptr, POSITION y, POSITION x);
+    void flush();
+    void clear();
+
+private:
+    LiteSpotQueue() = default;
+
+    static LiteSpotQueue instance;
+
+    PlayerType *player_ptr = nullptr;
+    std::vector<bool> is_queued{}; //!< グリッド毎の保留状態
+    std::vector<Pos2D> queued_grids{}; //!< 保留しているグリッドの一覧
+    std::vector<Pos2D> drawing_grids{}; //!< 描画中のグリッドの一覧
+};
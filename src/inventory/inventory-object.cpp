@@ -56,11 +56,11 @@ void inven_item_increase(PlayerType *player_ptr, INVENTORY_IDX item, ITEM_NUMBER
     o_ptr->number += num;
     auto &rfu = RedrawingFlagsUpdater::get_instance();
     static constexpr auto flags_srf = {
-        StatusRecalculatingFlag::BONUS,
         StatusRecalculatingFlag::MP,
         StatusRecalculatingFlag::COMBINATION,
     };
     rfu.set_flags(flags_srf);
+    rfu.set_flag((item < INVEN_MAIN_HAND) ? StatusRecalculatingFlag::BONUS_WEIGHT : StatusRecalculatingFlag::BONUS);
     static constexpr auto flags_swrf = {
         SubWindowRedrawingFlag::INVENTORY,
         SubWindowRedrawingFlag::EQUIPMENT,
@@ -337,7 +337,7 @@ int16_t store_item_to_inventory(PlayerType *player_ptr, ItemEntity *o_ptr)
         n = j;
         if (object_similar(j_ptr, o_ptr)) {
             object_absorb(j_ptr, o_ptr);
-            rfu.set_flag(StatusRecalculatingFlag::BONUS);
+            rfu.set_flag(StatusRecalculatingFlag::BONUS_WEIGHT);
             rfu.set_flags(flags_swrf);
             return j;
         }
@@ -379,7 +379,7 @@ int16_t store_item_to_inventory(PlayerType *player_ptr, ItemEntity *o_ptr)
 
     player_ptr->inven_cnt++;
     static constexpr auto flags_srf = {
-        StatusRecalculatingFlag::BONUS,
+        StatusRecalculatingFlag::BONUS_WEIGHT,
         StatusRecalculatingFlag::COMBINATION,
         StatusRecalculatingFlag::REORDER,
     };
@@ -121,8 +121,7 @@ static void dump_aux_quest(PlayerType *player_ptr, FILE *fff)
     for (const auto &[q_idx, quest] : quest_list) {
         quest_numbers.push_back(q_idx);
     }
-    int dummy;
-    ang_sort(player_ptr, quest_numbers.data(), &dummy, quest_numbers.size(), ang_sort_comp_quest_num, ang_sort_swap_quest_num);
+    sort_quest_ids(quest_numbers);
 
     fputc('\n', fff);
     do_cmd_knowledge_quests_completed(player_ptr, fff, quest_numbers);
@@ -145,7 +144,7 @@ static void dump_aux_last_message(PlayerType *player_ptr, FILE *fff)
     if (!w_ptr->total_winner) {
         fprintf(fff, _("\n  [死ぬ直前のメッセージ]\n\n", "\n  [Last Messages]\n\n"));
         for (int i = std::min(message_num(), 30); i >= 0; i--) {
-            fprintf(fff, "> %s\n", message_str((int16_t)i));
+            fprintf(fff, "> %s\n", message_str((int16_t)i).data());
         }
 
         fputc('\n', fff);
@@ -304,7 +303,7 @@ static void dump_aux_arena(PlayerType *player_ptr, FILE *fff)
  * @brief 撃破モンスターの情報をファイルにダンプする
  * @param fff ファイルポインタ
  */
-static void dump_aux_monsters(PlayerType *player_ptr, FILE *fff)
+static void dump_aux_monsters(FILE *fff)
 {
     fprintf(fff, _("\n  [倒したモンスター]\n\n", "\n  [Defeated Monsters]\n\n"));
 
@@ -363,7 +362,7 @@ static void dump_aux_monsters(PlayerType *player_ptr, FILE *fff)
 #endif
 
     /* Sort the array by dungeon depth of monsters */
-    ang_sort(player_ptr, who.data(), &why, uniq_total, ang_sort_comp_hook, ang_sort_swap_hook);
+    sort_monrace_ids(who, why);
     fprintf(fff, _("\n《上位%d体のユニーク・モンスター》\n", "\n< Unique monsters top %d >\n"), std::min(uniq_total, 10));
 
     char buf[80];
@@ -601,7 +600,7 @@ void make_character_dump(PlayerType *player_ptr, FILE *fff)
     dump_aux_recall(fff);
     dump_aux_quest(player_ptr, fff);
     dump_aux_arena(player_ptr, fff);
-    dump_aux_monsters(player_ptr, fff);
+    dump_aux_monsters(fff);
     dump_aux_virtues(player_ptr, fff);
     dump_aux_race_history(player_ptr, fff);
     dump_aux_realm_history(player_ptr, fff);
@@ -13,10 +13,16 @@
 #include "locale/japanese.h"
 #include "system/player-type-definition.h"
 #include "term/gameterm.h"
+#include "term/term-color-types.h"
 #include "term/z-form.h"
 #include "util/angband-files.h"
+#include "util/int-char-converter.h"
+#include "util/lz-codec.h"
 #include "view/display-messages.h"
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
 #include <sstream>
 #include <vector>
 
@@ -35,8 +41,16 @@
 #define FRESH_QUEUE_SIZE 4096
 #define DEFAULT_DELAY 50
 #define RECVBUF_SIZE 1024
-/* 「n」、「t」、および「w」コマンドでは、長さが「signed char」に配置されるときに負の値を回避するために、これよりも長い長さを使用しないでください。 */
-static constexpr auto SPLIT_MAX = 127;
+
+static constexpr std::string_view MOVIE_SIGNATURE = "AMV2"; /* 圧縮形式ムービーの識別子 */
+static constexpr auto BLOCK_HEADER_SIZE = 12; /* ブロックヘッダの長さ (先頭時刻、伸張後の長さ、圧縮後の長さ) */
+static constexpr auto KEYFRAME_INTERVAL = 10000; /* キーフレームを挟む間隔(ms単位) */
+static constexpr size_t BLOCK_SIZE_MAX = 256 * 1024; /* 1ブロックに溜める伸張後のデータ量の上限 */
+static constexpr auto MAX_RUN_GAP = 4; /* 変化した桁の間にこれ以下の変化していない桁しかなければ1つの区間にまとめる */
+static constexpr auto PLAYBACK_WAIT = 20; /* 再生時のウエイト(ms単位) */
+static constexpr std::array<int, 7> PLAYBACK_SPEEDS = { { 25, 50, 100, 200, 400, 800, 1600 } }; /* 再生速度(%) */
+static constexpr auto DEFAULT_SPEED_INDEX = 2;
+static constexpr TERM_COLOR ATTR_TILE = 0x80; /* タイルを表す属性 (z-termのAF_TILE1) */
 
 static long epoch_time; /* バッファ開始時刻 */
 static int browse_delay; /* 表示するまでの時間(100ms単位)(この間にラグを吸収する) */
@@ -62,20 +76,6 @@ static struct {
  * Original hooks
  */
 static errr (*old_xtra_hook)(int n, int v);
-static errr (*old_curs_hook)(int x, int y);
-static errr (*old_bigcurs_hook)(int x, int y);
-static errr (*old_wipe_hook)(int x, int y, int n);
-static errr (*old_text_hook)(int x, int y, int n, TERM_COLOR a, concptr s);
-
-static void disable_chuukei_server(void)
-{
-    term_type *t = angband_terms[0];
-    t->xtra_hook = old_xtra_hook;
-    t->curs_hook = old_curs_hook;
-    t->bigcurs_hook = old_bigcurs_hook;
-    t->wipe_hook = old_wipe_hook;
-    t->text_hook = old_text_hook;
-}
 
 /* ANSI Cによればstatic変数は0で初期化されるが一応初期化する */
 static void init_buffer(void)
@@ -100,22 +100,13 @@ static long get_current_time(void)
 }
 
 /*!
- * @brief リングバッファにヘッダとペイロードを追加する
+ * @brief 旧形式ムービーの再生用リングバッファにヘッダとペイロードを追加する
  * @param header ヘッダ
  * @param payload ペイロード (オプション)
  * @return エラーコード
  */
 static errr insert_ringbuf(std::string_view header, std::string_view payload = "")
 {
-    if (movie_mode) {
-        fd_write(movie_fd, header.data(), header.length());
-        if (!payload.empty()) {
-            fd_write(movie_fd, payload.data(), payload.length());
-        }
-        fd_write(movie_fd, "", 1);
-        return 0;
-    }
-
     /* バッファをオーバー */
     auto all_length = header.length() + payload.length();
     if (ring.inlen + all_length + 1 >= RINGBUF_SIZE) {
@@ -161,124 +152,287 @@ static errr insert_ringbuf(std::string_view header, std::string_view payload = "
     return 0;
 }
 
-/* strが同じ文字の繰り返しかどうか調べる */
-static bool string_is_repeat(concptr str, int len)
+/* 圧縮形式ムービーのフレーム種別 */
+enum class MovieFrameType : char {
+    KEY = 'K', /* 画面全体 */
+    DELTA = 'D', /* 直前のフレームから変化した区間のみ */
+};
+
+/*!
+ * @brief ムービーに記録する画面の内容
+ */
+struct MovieScreen {
+    int wid = 0;
+    int hgt = 0;
+    std::vector<TERM_COLOR> a{};
+    std::vector<char> c{};
+    bool is_cursor_visible = false;
+    int cx = 0;
+    int cy = 0;
+};
+
+/*!
+ * @brief 1行の中で変化した区間
+ */
+struct MovieRun {
+    int y;
+    int x;
+    int len;
+};
+
+static void append_u16(std::string &buf, int value)
 {
-    char c = str[0];
-    int i;
+    buf.push_back(static_cast<char>(value & 0xff));
+    buf.push_back(static_cast<char>((value >> 8) & 0xff));
+}
 
-    if (len < 2) {
-        return false;
+static void append_u32(std::string &buf, uint32_t value)
+{
+    append_u16(buf, value & 0xffff);
+    append_u16(buf, value >> 16);
+}
+
+/*!
+ * @brief 画面の差分をフレームとして録画する
+ * @details
+ * term_fresh() 毎にメインウィンドウの画面を直前のフレームと比べ、変化した区間だけをフレームとして溜める.
+ * 溜めたフレームは次のキーフレーム (画面全体) の直前に1ブロックとして圧縮し、ファイルに書き出す.
+ * 各ブロックはキーフレームから始まるので、再生時はブロック単位でシークできる.
+ */
+class MovieRecorder {
+public:
+    void start(int fd);
+    void record_frame(const term_type &term);
+    void finish();
+
+private:
+    int fd = -1;
+    std::chrono::steady_clock::time_point epoch{};
+    MovieScreen screen{};
+    MovieScreen last_screen{};
+    std::string block{};
+    uint32_t block_time = 0; //!< ブロック先頭のキーフレームの時刻
+    std::vector<MovieRun> runs{};
+
+    void capture(const term_type &term);
+    void write_frame_header(MovieFrameType type, uint32_t timestamp);
+    bool write_delta(uint32_t timestamp);
+    void find_changed_runs(int y);
+    void write_cells(int y, int x, int len);
+    void flush_block();
+};
+
+static MovieRecorder movie_recorder;
+
+/*!
+ * @brief 録画を開始する
+ * @param fd 書き出し先のファイル
+ */
+void MovieRecorder::start(int fd)
+{
+    this->fd = fd;
+    this->epoch = std::chrono::steady_clock::now();
+    this->last_screen = {};
+    this->block.clear();
+    fd_write(fd, MOVIE_SIGNATURE.data(), MOVIE_SIGNATURE.length());
+}
+
+/*!
+ * @brief 画面の内容をフレームとして記録する
+ * @param term メインウィンドウ
+ */
+void MovieRecorder::record_frame(const term_type &term)
+{
+    this->capture(term);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->epoch);
+    const auto timestamp = static_cast<uint32_t>(elapsed.count());
+    const auto is_resized = (this->screen.wid != this->last_screen.wid) || (this->screen.hgt != this->last_screen.hgt);
+    if (this->block.empty() || is_resized || (timestamp - this->block_time >= KEYFRAME_INTERVAL) || (this->block.length() >= BLOCK_SIZE_MAX)) {
+        this->flush_block();
+        this->block_time = timestamp;
+        this->write_frame_header(MovieFrameType::KEY, timestamp);
+        append_u16(this->block, this->screen.wid);
+        append_u16(this->block, this->screen.hgt);
+        for (auto y = 0; y < this->screen.hgt; y++) {
+            this->write_cells(y, 0, this->screen.wid);
+        }
+    } else if (!this->write_delta(timestamp)) {
+        return;
     }
-#ifdef JP
-    if (iskanji(c)) {
+
+    std::swap(this->screen, this->last_screen);
+}
+
+/*!
+ * @brief 溜めているフレームを書き出して録画を終える
+ */
+void MovieRecorder::finish()
+{
+    this->flush_block();
+    this->fd = -1;
+}
+
+void MovieRecorder::capture(const term_type &term)
+{
+    const auto &scr = *term.scr;
+    const auto wid = term.wid;
+    this->screen.wid = wid;
+    this->screen.hgt = term.hgt;
+    this->screen.a.resize(static_cast<size_t>(wid) * term.hgt);
+    this->screen.c.resize(static_cast<size_t>(wid) * term.hgt);
+    for (auto y = 0; y < term.hgt; y++) {
+        std::copy_n(scr.a[y], wid, &this->screen.a[static_cast<size_t>(y) * wid]);
+        std::copy_n(scr.c[y], wid, &this->screen.c[static_cast<size_t>(y) * wid]);
+    }
+
+    this->screen.is_cursor_visible = scr.cv && !scr.cu;
+    this->screen.cx = scr.cx;
+    this->screen.cy = scr.cy;
+}
+
+void MovieRecorder::write_frame_header(MovieFrameType type, uint32_t timestamp)
+{
+    this->block.push_back(static_cast<char>(type));
+    append_u32(this->block, timestamp);
+    this->block.push_back(this->screen.is_cursor_visible ? 1 : 0);
+    append_u16(this->block, this->screen.cx);
+    append_u16(this->block, this->screen.cy);
+}
+
+/*!
+ * @brief 直前のフレームから変化した区間をフレームとして書き込む
+ * @param timestamp 録画開始からの時刻(ms単位)
+ * @return 画面もカーソルも変化していなければ何もせずfalse
+ */
+bool MovieRecorder::write_delta(uint32_t timestamp)
+{
+    this->runs.clear();
+    for (auto y = 0; y < this->screen.hgt; y++) {
+        this->find_changed_runs(y);
+    }
+
+    const auto &last = this->last_screen;
+    const auto is_cursor_changed = (this->screen.is_cursor_visible != last.is_cursor_visible) || (this->screen.cx != last.cx) || (this->screen.cy != last.cy);
+    if (this->runs.empty() && !is_cursor_changed) {
         return false;
     }
-#endif
 
-    for (i = 1; i < len; i++) {
-#ifdef JP
-        if (c != str[i] || iskanji(str[i])) {
-            return false;
-        }
-#else
-        if (c != str[i]) {
-            return false;
-        }
-#endif
+    this->write_frame_header(MovieFrameType::DELTA, timestamp);
+    append_u16(this->block, static_cast<int>(this->runs.size()));
+    for (const auto &[y, x, len] : this->runs) {
+        append_u16(this->block, y);
+        append_u16(this->block, x);
+        append_u16(this->block, len);
+        this->write_cells(y, x, len);
     }
 
     return true;
 }
 
+/*!
+ * @brief 1行の中で変化した区間を探す
+ * @param y 行
+ * @details 近くにある変化はまとめ、全角文字は分割しない.
+ */
+void MovieRecorder::find_changed_runs(int y)
+{
+    const auto wid = this->screen.wid;
+    const auto base = static_cast<size_t>(y) * wid;
+    const auto &last = this->last_screen;
+    const auto is_changed = [&](int x) {
+        return (this->screen.a[base + x] != last.a[base + x]) || (this->screen.c[base + x] != last.c[base + x]);
+    };
+
 #ifdef JP
-/* マルチバイト文字を分割せずに str を分割する長さを len 以下で返す */
-static int find_split(concptr str, int len)
-{
-    /*
-     * SJIS が定義されている場合でも、str は常に EUC-JP としてエンコードされます。
-     * 他の場所で行われているような 3 バイトのエンコーディングは想定していません。
-     */
-    int last_split = 0, i = 0;
-    while (i < len) {
-        if (iseuckanji(str[i])) {
-            if (i < len - 1) {
-                last_split = i + 2;
-            }
-            i += 2;
-        } else {
-            last_split = i + 1;
-            ++i;
-        }
-    }
-    return last_split;
-}
+    std::vector<bool> is_kanji_tail;
 #endif
+    for (auto x = 0; x < wid;) {
+        if (!is_changed(x)) {
+            x++;
+            continue;
+        }
 
-static errr send_text_to_chuukei_server(TERM_LEN x, TERM_LEN y, int len, TERM_COLOR col, concptr str)
-{
-    if (len == 1) {
-        insert_ringbuf(format("s%c%c%c%c", x + 1, y + 1, col, *str));
-        return (*old_text_hook)(x, y, len, col, str);
-    }
+        auto x1 = x;
+        auto x2 = x;
+        for (x++; (x < wid) && (x - x2 <= MAX_RUN_GAP); x++) {
+            if (is_changed(x)) {
+                x2 = x;
+            }
+        }
 
-    if (string_is_repeat(str, len)) {
-        while (len > SPLIT_MAX) {
-            insert_ringbuf(format("n%c%c%c%c%c", x + 1, y + 1, SPLIT_MAX, col, *str));
-            x += SPLIT_MAX;
-            len -= SPLIT_MAX;
+#ifdef JP
+        if (is_kanji_tail.empty()) {
+            is_kanji_tail.resize(wid);
+            for (auto i = 0; i < wid - 1; i++) {
+                if (!(this->screen.a[base + i] & ATTR_TILE) && iskanji(this->screen.c[base + i])) {
+                    is_kanji_tail[++i] = true;
+                }
+            }
         }
 
-        std::string formatted_text;
-        if (len > 1) {
-            formatted_text = format("n%c%c%c%c%c", x + 1, y + 1, len, col, *str);
-        } else {
-            formatted_text = format("s%c%c%c%c", x + 1, y + 1, col, *str);
+        if (is_kanji_tail[x1]) {
+            x1--;
         }
 
-        insert_ringbuf(formatted_text);
-        return (*old_text_hook)(x, y, len, col, str);
+        if ((x2 + 1 < wid) && is_kanji_tail[x2 + 1]) {
+            x2++;
+        }
+#endif
+        this->runs.push_back({ y, x1, x2 - x1 + 1 });
     }
+}
 
+/*!
+ * @brief 区間の属性と文字を書き込む
+ * @details 文字コードは旧形式と同じくEUC-JPに揃える.
+ */
+void MovieRecorder::write_cells(int y, int x, int len)
+{
+    const auto pos = static_cast<size_t>(y) * this->screen.wid + x;
+    const auto *aa = &this->screen.a[pos];
+    this->block.append(reinterpret_cast<const char *>(aa), len);
 #if defined(SJIS) && defined(JP)
-    std::string buffer = str; // strは書き換わって欲しくないのでコピーする.
-    auto *payload = buffer.data();
-    sjis2euc(payload);
-#else
-    const auto *payload = str;
-#endif
-    while (len > SPLIT_MAX) {
-        auto split_len = _(find_split(payload, SPLIT_MAX), SPLIT_MAX);
-        insert_ringbuf(format("t%c%c%c%c", x + 1, y + 1, split_len, col), std::string_view(payload, split_len));
-        x += split_len;
-        len -= split_len;
-        payload += split_len;
+    std::string text(&this->screen.c[pos], len);
+    for (auto i = 0; i < len - 1; i++) {
+        if ((aa[i] & ATTR_TILE) || !iskanji(text[i])) {
+            continue;
+        }
+
+        char kanji[] = { text[i], text[i + 1], '\0' };
+        sjis2euc(kanji);
+        text[i] = kanji[0];
+        text[++i] = kanji[1];
     }
 
-    insert_ringbuf(format("t%c%c%c%c", x + 1, y + 1, len, col), std::string_view(payload, len));
-    return (*old_text_hook)(x, y, len, col, str);
+    this->block.append(text);
+#else
+    this->block.append(&this->screen.c[pos], len);
+#endif
 }
 
-static errr send_wipe_to_chuukei_server(int x, int y, int len)
+/*!
+ * @brief 溜めているフレームを1ブロックとして圧縮し、書き出す
+ */
+void MovieRecorder::flush_block()
 {
-    while (len > SPLIT_MAX) {
-        insert_ringbuf(format("w%c%c%c", x + 1, y + 1, SPLIT_MAX));
-        x += SPLIT_MAX;
-        len -= SPLIT_MAX;
+    if (this->block.empty()) {
+        return;
     }
-    insert_ringbuf(format("w%c%c%c", x + 1, y + 1, len));
 
-    return (*old_wipe_hook)(x, y, len);
+    const auto compressed = lz_compress(this->block);
+    std::string header;
+    append_u32(header, this->block_time);
+    append_u32(header, static_cast<uint32_t>(this->block.length()));
+    append_u32(header, static_cast<uint32_t>(compressed.length()));
+    fd_write(this->fd, header.data(), header.length());
+    fd_write(this->fd, compressed.data(), compressed.length());
+    this->block.clear();
 }
 
-static errr send_xtra_to_chuukei_server(int n, int v)
+static errr record_movie_xtra(int n, int v)
 {
-    if (n == TERM_XTRA_CLEAR || n == TERM_XTRA_FRESH || n == TERM_XTRA_SHAPE) {
-        insert_ringbuf(format("x%c", n + 1));
-
-        if (n == TERM_XTRA_FRESH) {
-            insert_ringbuf("d", std::to_string(get_current_time() - epoch_time));
-        }
+    if (n == TERM_XTRA_FRESH) {
+        movie_recorder.record_frame(*angband_terms[0]);
     }
 
     /* Verify the hook */
@@ -289,53 +443,30 @@ static errr send_xtra_to_chuukei_server(int n, int v)
     return (*old_xtra_hook)(n, v);
 }
 
-static errr send_curs_to_chuukei_server(int x, int y)
-{
-    insert_ringbuf(format("c%c%c", x + 1, y + 1));
-
-    return (*old_curs_hook)(x, y);
-}
-
-static errr send_bigcurs_to_chuukei_server(int x, int y)
-{
-    insert_ringbuf(format("C%c%c", x + 1, y + 1));
-
-    return (*old_bigcurs_hook)(x, y);
-}
-
-/*
- * Prepare z-term hooks to call send_*_to_chuukei_server()'s
+/*!
+ * @brief 録画中なら録画を終了する
  */
-void prepare_chuukei_hooks(void)
+void stop_movie_recording()
 {
-    term_type *t0 = angband_terms[0];
-
-    /* Save original z-term hooks */
-    old_xtra_hook = t0->xtra_hook;
-    old_curs_hook = t0->curs_hook;
-    old_bigcurs_hook = t0->bigcurs_hook;
-    old_wipe_hook = t0->wipe_hook;
-    old_text_hook = t0->text_hook;
+    if (!movie_mode) {
+        return;
+    }
 
-    /* Prepare z-term hooks */
-    t0->xtra_hook = send_xtra_to_chuukei_server;
-    t0->curs_hook = send_curs_to_chuukei_server;
-    t0->bigcurs_hook = send_bigcurs_to_chuukei_server;
-    t0->wipe_hook = send_wipe_to_chuukei_server;
-    t0->text_hook = send_text_to_chuukei_server;
+    movie_mode = 0;
+    angband_terms[0]->xtra_hook = old_xtra_hook;
+    movie_recorder.finish();
+    fd_close(movie_fd);
 }
 
 /*
- * Prepare z-term hooks to call send_*_to_chuukei_server()'s
+ * Prepare z-term hooks to record movie
  */
 void prepare_movie_hooks(PlayerType *player_ptr)
 {
     TermCenteredOffsetSetter tcos(std::nullopt, std::nullopt);
 
     if (movie_mode) {
-        movie_mode = 0;
-        disable_chuukei_server();
-        fd_close(movie_fd);
+        stop_movie_recording();
         msg_print(_("録画を終了しました。", "Stopped recording."));
         return;
     }
@@ -364,13 +495,15 @@ void prepare_movie_hooks(PlayerType *player_ptr)
         movie_fd = fd_make(path);
     }
 
-    if (!movie_fd) {
+    if (movie_fd < 0) {
         msg_print(_("ファイルを開けません！", "Can not open file."));
         return;
     }
 
     movie_mode = 1;
-    prepare_chuukei_hooks();
+    movie_recorder.start(movie_fd);
+    old_xtra_hook = angband_terms[0]->xtra_hook;
+    angband_terms[0]->xtra_hook = record_movie_xtra;
     do_cmd_redraw(player_ptr);
 }
 
@@ -446,15 +579,21 @@ static int read_movie_file(void)
 
 #ifndef WINDOWS
 /* Win版の床の中点と壁の豆腐をピリオドとシャープにする。*/
-static void win2unix(int col, char *buf)
+static char win2unix_char(int col, char c)
 {
-    char wall;
-    if (col == 9) {
-        wall = '%';
-    } else {
-        wall = '#';
+    if (c == 127) {
+        return (col == 9) ? '%' : '#';
+    }
+
+    if (c == 31) {
+        return '.';
     }
 
+    return c;
+}
+
+static void win2unix(int col, char *buf)
+{
     while (*buf) {
 #ifdef JP
         if (iskanji(*buf)) {
@@ -462,11 +601,7 @@ static void win2unix(int col, char *buf)
             continue;
         }
 #endif
-        if (*buf == 127) {
-            *buf = wall;
-        } else if (*buf == 31) {
-            *buf = '.';
-        }
+        *buf = win2unix_char(col, *buf);
         buf++;
     }
 }
@@ -614,6 +749,363 @@ static bool flush_ringbuf_client()
     return true;
 }
 
+/*!
+ * @brief 圧縮形式ムービーのブロックの位置
+ */
+struct MovieBlock {
+    ulong offset; //!< 圧縮データのファイル上の位置
+    uint32_t timestamp; //!< 先頭のキーフレームの時刻
+    uint32_t raw_size;
+    uint32_t compressed_size;
+};
+
+/*!
+ * @brief ムービーのデータを先頭から読み出す
+ * @details 範囲外を読もうとした時は0か空を返し、以後 is_broken() がtrueを返す.
+ */
+class MovieDataReader {
+public:
+    MovieDataReader(std::string_view data)
+        : data(data)
+    {
+    }
+
+    bool is_end() const
+    {
+        return this->broken || (this->pos >= this->data.length());
+    }
+
+    bool is_broken() const
+    {
+        return this->broken;
+    }
+
+    int read_u8()
+    {
+        const auto bytes = this->read_bytes(1);
+        return bytes.empty() ? 0 : static_cast<uint8_t>(bytes[0]);
+    }
+
+    int read_u16()
+    {
+        const auto bytes = this->read_bytes(2);
+        return bytes.empty() ? 0 : static_cast<uint8_t>(bytes[0]) | (static_cast<uint8_t>(bytes[1]) << 8);
+    }
+
+    uint32_t read_u32()
+    {
+        const uint32_t low = this->read_u16();
+        const uint32_t high = this->read_u16();
+        return low | (high << 16);
+    }
+
+    std::string_view read_bytes(size_t length)
+    {
+        if (this->broken || (length > this->data.length() - this->pos)) {
+            this->broken = true;
+            return {};
+        }
+
+        const auto bytes = this->data.substr(this->pos, length);
+        this->pos += length;
+        return bytes;
+    }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+    bool broken = false;
+};
+
+/* 再生中のキー入力による指示 */
+enum class MoviePlaybackCommand {
+    NONE,
+    NEXT_BLOCK,
+    PREV_BLOCK,
+    QUIT,
+};
+
+/*!
+ * @brief 圧縮形式ムービーを再生する
+ * @details
+ * 再生中は以下のキーを受け付ける.
+ * - '+' / '-' : 再生速度を上げる / 下げる
+ * - ' ' : 一時停止 / 再開
+ * - '>' / '<' : 次 / 前のキーフレームに移動する
+ * - ESC / 'q' : 再生を終える
+ */
+class MoviePlayer {
+public:
+    MoviePlayer(int fd)
+        : fd(fd)
+    {
+    }
+
+    void play();
+
+private:
+    int fd;
+    std::vector<MovieBlock> blocks{};
+    size_t speed_index = DEFAULT_SPEED_INDEX;
+    bool is_paused = false;
+    double movie_time = 0; //!< 再生位置(ms単位)
+    std::chrono::steady_clock::time_point last_tick{};
+
+    void load_blocks();
+    std::optional<std::string> read_block(const MovieBlock &block) const;
+    MoviePlaybackCommand play_block(std::string_view data);
+    MoviePlaybackCommand wait_until(uint32_t timestamp);
+    MoviePlaybackCommand process_key(char key);
+    bool apply_frame(MovieFrameType type, MovieDataReader &reader);
+    void queue_cells(int y, int x, int len, MovieDataReader &reader);
+};
+
+void MoviePlayer::play()
+{
+    this->load_blocks();
+    this->last_tick = std::chrono::steady_clock::now();
+    size_t index = 0;
+    while (index < this->blocks.size()) {
+        const auto data = this->read_block(this->blocks[index]);
+        if (!data) {
+            return;
+        }
+
+        const auto command = this->play_block(*data);
+        switch (command) {
+        case MoviePlaybackCommand::NONE:
+        case MoviePlaybackCommand::NEXT_BLOCK:
+            index++;
+            break;
+        case MoviePlaybackCommand::PREV_BLOCK:
+            index = (index > 0) ? index - 1 : 0;
+            break;
+        case MoviePlaybackCommand::QUIT:
+            return;
+        }
+
+        if ((command != MoviePlaybackCommand::NONE) && (index < this->blocks.size())) {
+            this->movie_time = this->blocks[index].timestamp;
+        }
+    }
+}
+
+/*!
+ * @brief ブロックの索引を作る
+ * @details ブロックヘッダだけを辿るので、ファイル全体を読まずにシークできる.
+ * 録画が中断された等で途切れているブロックは無視する.
+ */
+void MoviePlayer::load_blocks()
+{
+    ulong offset = MOVIE_SIGNATURE.length();
+    while (true) {
+        char header[BLOCK_HEADER_SIZE];
+        if (fd_seek(this->fd, offset) || fd_read(this->fd, header, sizeof(header))) {
+            return;
+        }
+
+        MovieDataReader reader(std::string_view(header, sizeof(header)));
+        MovieBlock block{};
+        block.offset = offset + sizeof(header);
+        block.timestamp = reader.read_u32();
+        block.raw_size = reader.read_u32();
+        block.compressed_size = reader.read_u32();
+        this->blocks.push_back(block);
+        offset = block.offset + block.compressed_size;
+    }
+}
+
+std::optional<std::string> MoviePlayer::read_block(const MovieBlock &block) const
+{
+    std::string compressed(block.compressed_size, '\0');
+    if (fd_seek(this->fd, block.offset) || fd_read(this->fd, compressed.data(), compressed.length())) {
+        return std::nullopt;
+    }
+
+    return lz_decompress(compressed, block.raw_size);
+}
+
+MoviePlaybackCommand MoviePlayer::play_block(std::string_view data)
+{
+    MovieDataReader reader(data);
+    while (!reader.is_end()) {
+        const auto type = static_cast<MovieFrameType>(reader.read_u8());
+        const auto timestamp = reader.read_u32();
+        if (const auto command = this->wait_until(timestamp); command != MoviePlaybackCommand::NONE) {
+            return command;
+        }
+
+        if (!this->apply_frame(type, reader)) {
+            return MoviePlaybackCommand::NEXT_BLOCK;
+        }
+    }
+
+    return MoviePlaybackCommand::NONE;
+}
+
+/*!
+ * @brief 再生位置がフレームの時刻に達するまで待つ
+ * @param timestamp フレームの時刻(ms単位)
+ * @return 待っている間に受け付けた指示
+ */
+MoviePlaybackCommand MoviePlayer::wait_until(uint32_t timestamp)
+{
+    while (true) {
+        char key;
+        while (term_inkey(&key, false, true) == 0) {
+            if (const auto command = this->process_key(key); command != MoviePlaybackCommand::NONE) {
+                return command;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration<double, std::milli>(now - this->last_tick).count();
+        this->last_tick = now;
+        if (!this->is_paused) {
+            this->movie_time += elapsed * PLAYBACK_SPEEDS[this->speed_index] / 100;
+        }
+
+        if (!this->is_paused && (this->movie_time >= timestamp)) {
+            return MoviePlaybackCommand::NONE;
+        }
+
+        term_xtra(TERM_XTRA_DELAY, PLAYBACK_WAIT);
+    }
+}
+
+MoviePlaybackCommand MoviePlayer::process_key(char key)
+{
+    switch (key) {
+    case '+':
+        this->speed_index = std::min(this->speed_index + 1, PLAYBACK_SPEEDS.size() - 1);
+        return MoviePlaybackCommand::NONE;
+    case '-':
+        this->speed_index = (this->speed_index > 0) ? this->speed_index - 1 : 0;
+        return MoviePlaybackCommand::NONE;
+    case ' ':
+        this->is_paused = !this->is_paused;
+        return MoviePlaybackCommand::NONE;
+    case '>':
+        return MoviePlaybackCommand::NEXT_BLOCK;
+    case '<':
+        return MoviePlaybackCommand::PREV_BLOCK;
+    case ESCAPE:
+    case 'q':
+        return MoviePlaybackCommand::QUIT;
+    default:
+        return MoviePlaybackCommand::NONE;
+    }
+}
+
+/*!
+ * @brief フレームを画面に反映する
+ * @return フレームが壊れていればfalse
+ */
+bool MoviePlayer::apply_frame(MovieFrameType type, MovieDataReader &reader)
+{
+    const auto is_cursor_visible = reader.read_u8() != 0;
+    const auto cx = reader.read_u16();
+    const auto cy = reader.read_u16();
+    switch (type) {
+    case MovieFrameType::KEY: {
+        const auto wid = reader.read_u16();
+        const auto hgt = reader.read_u16();
+        if (reader.is_broken()) {
+            return false;
+        }
+
+        if ((wid != game_term->wid) || (hgt != game_term->hgt)) {
+            term_resize(wid, hgt);
+        }
+
+        for (auto y = 0; y < hgt; y++) {
+            this->queue_cells(y, 0, wid, reader);
+        }
+
+        break;
+    }
+    case MovieFrameType::DELTA: {
+        const auto num_runs = reader.read_u16();
+        for (auto i = 0; i < num_runs; i++) {
+            const auto y = reader.read_u16();
+            const auto x = reader.read_u16();
+            const auto len = reader.read_u16();
+            this->queue_cells(y, x, len, reader);
+        }
+
+        break;
+    }
+    default:
+        return false;
+    }
+
+    if (reader.is_broken()) {
+        return false;
+    }
+
+    (void)term_gotoxy(cx, cy);
+    (void)term_set_cursor(is_cursor_visible);
+    term_fresh();
+    return true;
+}
+
+/*!
+ * @brief 区間の属性と文字を画面に反映する
+ * @details 画面に収まらない部分は捨てる.
+ */
+void MoviePlayer::queue_cells(int y, int x, int len, MovieDataReader &reader)
+{
+    const auto attrs = reader.read_bytes(len);
+    const auto chars = reader.read_bytes(len);
+    if (reader.is_broken() || (y >= game_term->hgt) || (x >= game_term->wid)) {
+        return;
+    }
+
+    len = std::min(len, game_term->wid - x);
+    std::vector<TERM_COLOR> aa(attrs.begin(), attrs.begin() + len);
+    std::vector<char> cc(chars.begin(), chars.begin() + len);
+    for (auto i = 0; i < len; i++) {
+        /* タイルを表示できなければ空白にする */
+        if ((aa[i] & ATTR_TILE) && (cc[i] & 0x80) && !game_term->higher_pict) {
+            aa[i] = TERM_WHITE;
+            cc[i] = ' ';
+            continue;
+        }
+
+#if defined(SJIS) && defined(JP)
+        if (iseuckanji(cc[i]) && (i + 1 < len)) {
+            char kanji[] = { cc[i], cc[i + 1], '\0' };
+            euc2sjis(kanji);
+            cc[i] = kanji[0];
+            cc[++i] = kanji[1];
+            continue;
+        }
+#endif
+#ifndef WINDOWS
+        cc[i] = win2unix_char(aa[i], cc[i]);
+#endif
+    }
+
+    std::vector<TERM_COLOR> taa(len);
+    std::vector<char> tcc(len);
+    term_queue_line(x, y, len, aa.data(), cc.data(), taa.data(), tcc.data());
+}
+
+/*!
+ * @brief 圧縮形式のムービーかどうかを調べる
+ * @return 圧縮形式ならtrue. 旧形式ならファイルの先頭に戻してfalse
+ */
+static bool is_compressed_movie()
+{
+    char signature[MOVIE_SIGNATURE.length()];
+    if (!fd_read(movie_fd, signature, sizeof(signature)) && (std::string_view(signature, sizeof(signature)) == MOVIE_SIGNATURE)) {
+        return true;
+    }
+
+    (void)fd_seek(movie_fd, 0);
+    return false;
+}
+
 void prepare_browse_movie_without_path_build(const std::filesystem::path &path)
 {
     movie_fd = fd_open(path, O_RDONLY);
@@ -626,6 +1118,11 @@ void browse_movie(void)
     term_fresh();
     term_xtra(TERM_XTRA_REACT, 0);
 
+    if (is_compressed_movie()) {
+        MoviePlayer(movie_fd).play();
+        return;
+    }
+
     while (read_movie_file() == 0) {
         while (fresh_queue.next != fresh_queue.tail) {
             if (!flush_ringbuf_client()) {
@@ -5,6 +5,7 @@
 
 class PlayerType;
 void prepare_movie_hooks(PlayerType *player_ptr);
+void stop_movie_recording();
 void prepare_browse_movie_without_path_build(const std::filesystem::path &path);
 void browse_movie();
 #ifndef WINDOWS
@@ -10,10 +10,10 @@
 #include "core/stuff-handler.h"
 #include "core/turn-compensator.h"
 #include "core/visuals-reseter.h"
-#include "external-lib/include-httplib.h"
 #include "game-option/special-options.h"
 #include "io-dump/character-dump.h"
 #include "io/input-key-acceptor.h"
+#include "io/score-upload-queue.h"
 #include "mind/mind-elementalist.h"
 #include "player-base/player-class.h"
 #include "player-info/class-info.h"
@@ -45,16 +45,6 @@
 
 concptr screen_dump = nullptr;
 
-/*
- * internet resource value
- */
-constexpr auto HTTP_CONNECTION_TIMEOUT = 30; /*!< HTTP接続タイムアウト時間(秒) */
-
-#ifdef JP
-constexpr auto SCORE_SERVER_SCHEME_HOST = "http://mars.kmc.gr.jp"; /*!< スコアサーバホスト */
-constexpr auto SCORE_SERVER_PATH = "/~dis/heng_score/register_score.php"; /*< スコアサーバパス */
-#endif
-
 size_t read_callback(char *buffer, size_t size, size_t nitems, void *userdata)
 {
     auto &data = *static_cast<std::span<const char> *>(userdata);
@@ -66,39 +56,6 @@ size_t read_callback(char *buffer, size_t size, size_t nitems, void *userdata)
     return copy_size;
 }
 
-/*!
- * @brief HTTPによるダンプ内容伝送
- * @param score ダンプ内容
- * @return 送信に成功した場合TRUE、失敗した場合FALSE
- */
-static bool report_score(const std::string &score)
-{
-    httplib::Client cli(SCORE_SERVER_SCHEME_HOST);
-    cli.set_connection_timeout(HTTP_CONNECTION_TIMEOUT);
-    cli.set_follow_location(true);
-
-    httplib::Headers headers = {
-        { "User-Agent", format("Hengband %d.%d.%d", H_VER_MAJOR, H_VER_MINOR, H_VER_PATCH) }
-    };
-
-    auto content_type =
-#ifdef JP
-#ifdef SJIS
-        "text/plain; charset=SHIFT_JIS"
-#endif
-#ifdef EUC
-        "text/plain; charset=EUC-JP"
-#endif
-#else
-        "text/plain; charset=ASCII"
-#endif
-        ;
-
-    const auto res = cli.Post(SCORE_SERVER_PATH, score, content_type);
-
-    return res->status == 200;
-}
-
 /*!
  * @brief キャラクタダンプを引数で指定した出力ストリームに書き込む
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -270,7 +227,8 @@ concptr make_screen_dump(PlayerType *player_ptr)
 /*!
  * @brief スコア転送処理のメインルーチン
  * @param player_ptr プレイヤーへの参照ポインタ
- * @return 正常にスコアを送信できたらtrue、失敗時に送信を中止したらfalse
+ * @return スコアを送信待ちに加えたらtrue、失敗時に送信を中止したらfalse
+ * @details 実際の送信は ScoreUploadQueue がバックグラウンドで行う.
  */
 bool report_score(PlayerType *player_ptr)
 {
@@ -307,16 +265,13 @@ bool report_score(PlayerType *player_ptr)
 
     term_clear();
     while (true) {
-        term_fresh();
-        prt(_("スコア送信中...", "Sending the score..."), 0, 0);
-        term_fresh();
-        if (report_score(score_data)) {
+        if (ScoreUploadQueue::get_instance().enqueue(score_data)) {
             return true;
         }
 
-        prt(_("スコア・サーバへの送信に失敗しました。", "Failed to send to the score server."), 0, 0);
+        prt(_("スコアを送信待ちに保存できませんでした。", "Failed to queue the score for sending."), 0, 0);
         (void)inkey();
-        if (get_check_strict(player_ptr, _("もう一度接続を試みますか? ", "Try again? "), CHECK_NO_HISTORY)) {
+        if (get_check_strict(player_ptr, _("もう一度試みますか? ", "Try again? "), CHECK_NO_HISTORY)) {
             continue;
         }
 
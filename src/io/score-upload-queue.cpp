@@ -0,0 +1,310 @@
+﻿/*!
+ * @file score-upload-queue.cpp
+ * @brief スコアサーバへの非同期送信処理
+ */
+
+#include "io/score-upload-queue.h"
+
+#ifdef WORLD_SCORE
+#include "external-lib/include-httplib.h"
+#include "io/files-util.h"
+#include "term/z-form.h"
+#include "util/angband-files.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * internet resource value
+ */
+constexpr auto HTTP_CONNECTION_TIMEOUT = 30; /*!< HTTP接続タイムアウト時間(秒) */
+
+constexpr auto SCORE_SERVER_SCHEME_HOST = "http://mars.kmc.gr.jp"; /*!< スコアサーバホスト */
+constexpr auto SCORE_SERVER_PATH = "/~dis/heng_score/register_score.php"; /*< スコアサーバパス */
+constexpr auto SCORE_SERVER_ENV = "ANGBAND_SCORE_SERVER"; /*!< スコアサーバホストを差し替える環境変数 */
+
+constexpr auto SPOOL_DIR_NAME = "score-spool"; /*!< スプールディレクトリ名 */
+constexpr auto ENTRY_EXTENSION = ".txt"; /*!< 送信待ちのファイルの拡張子 */
+constexpr auto WRITING_EXTENSION = ".tmp"; /*!< 書き込み中のファイルの拡張子 */
+constexpr auto REJECTED_EXTENSION = ".rejected"; /*!< サーバに拒否されたファイルの拡張子 */
+
+constexpr std::chrono::seconds RETRY_WAIT_MIN(30); /*!< 送信に失敗してから再送するまでの最短時間 */
+constexpr std::chrono::seconds RETRY_WAIT_MAX(600); /*!< 送信に失敗してから再送するまでの最長時間 */
+constexpr std::chrono::seconds SHUTDOWN_WAIT(3); /*!< 終了時に送信の完了を待つ時間 */
+constexpr std::chrono::seconds STOP_WAIT(1); /*!< 送信を打ち切ってからスレッドの終了を待つ時間 */
+
+/*!
+ * @brief 送信スレッドと共有する状態
+ * @details 終了時にスレッドを待ち切れず切り離した後も、スレッドが参照し続けられるよう共有ポインタで持つ.
+ */
+struct ScoreUploadState {
+    std::filesystem::path spool_dir{};
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    bool has_new_entry = false; //!< 未送信のファイルが追加された
+    bool is_sending = false; //!< 送信処理中
+    bool is_stopping = false; //!< 終了要求
+    bool is_running = false; //!< 送信スレッドの実行中
+    httplib::Client *client = nullptr; //!< 送信中のクライアント (終了時に通信を打ち切るため)
+};
+
+ScoreUploadQueue ScoreUploadQueue::instance{};
+
+/*!
+ * @brief 送信待ちのファイルを古い順に列挙する
+ * @param spool_dir スプールディレクトリ
+ * @return ファイルパスのリスト
+ */
+static std::vector<std::filesystem::path> list_entries(const std::filesystem::path &spool_dir)
+{
+    std::vector<std::filesystem::path> entries;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(spool_dir, ec)) {
+        if (entry.is_regular_file(ec) && (entry.path().extension() == ENTRY_EXTENSION)) {
+            entries.push_back(entry.path());
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+/*!
+ * @brief 送信待ちのファイルを1件送信する
+ * @param state 共有状態
+ * @param path ファイルパス
+ * @return 送信を終えた (成功した、またはサーバに拒否された) ならtrue、後で再送すべきならfalse
+ */
+static bool send_entry(ScoreUploadState &state, const std::filesystem::path &path)
+{
+    std::stringstream score_ss;
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs) {
+            return true;
+        }
+
+        score_ss << ifs.rdbuf();
+    }
+
+    const auto *server = std::getenv(SCORE_SERVER_ENV);
+    httplib::Client cli(server ? server : SCORE_SERVER_SCHEME_HOST);
+    cli.set_connection_timeout(HTTP_CONNECTION_TIMEOUT);
+    cli.set_follow_location(true);
+
+    auto content_type =
+#ifdef JP
+#ifdef SJIS
+        "text/plain; charset=SHIFT_JIS"
+#endif
+#ifdef EUC
+        "text/plain; charset=EUC-JP"
+#endif
+#else
+        "text/plain; charset=ASCII"
+#endif
+        ;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.is_stopping) {
+            return false;
+        }
+
+        state.client = &cli;
+    }
+
+    const auto res = cli.Post(SCORE_SERVER_PATH, score_ss.str(), content_type);
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.client = nullptr;
+    }
+
+    if (!res) {
+        return false;
+    }
+
+    std::error_code ec;
+    if (res->status == 200) {
+        std::filesystem::remove(path, ec);
+        return true;
+    }
+
+    if ((res->status >= 400) && (res->status < 500)) {
+        auto rejected_path = path;
+        rejected_path.replace_extension(REJECTED_EXTENSION);
+        std::filesystem::rename(path, rejected_path, ec);
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * @brief 送信スレッドの本体
+ * @param state 共有状態
+ * @details 送信待ちのファイルを全て送るか送信に失敗するまで送り、次の追加か再送の時刻まで待つ.
+ */
+static void run_upload(std::shared_ptr<ScoreUploadState> state)
+{
+    auto retry_wait = RETRY_WAIT_MIN;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (!state->is_stopping) {
+        state->has_new_entry = false;
+        state->is_sending = true;
+        lock.unlock();
+        auto is_all_sent = true;
+        for (const auto &path : list_entries(state->spool_dir)) {
+            if (!send_entry(*state, path)) {
+                is_all_sent = false;
+                break;
+            }
+        }
+
+        lock.lock();
+        state->is_sending = false;
+        state->cv.notify_all();
+        const auto has_work = [&state] { return state->is_stopping || state->has_new_entry; };
+        if (is_all_sent) {
+            retry_wait = RETRY_WAIT_MIN;
+            state->cv.wait(lock, has_work);
+            continue;
+        }
+
+        state->cv.wait_for(lock, retry_wait, has_work);
+        retry_wait = std::min(retry_wait * 2, RETRY_WAIT_MAX);
+    }
+
+    state->is_running = false;
+    state->cv.notify_all();
+}
+
+ScoreUploadQueue::ScoreUploadQueue()
+    : state(std::make_shared<ScoreUploadState>())
+{
+}
+
+ScoreUploadQueue::~ScoreUploadQueue()
+{
+    this->shutdown();
+}
+
+ScoreUploadQueue &ScoreUploadQueue::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 前回までに送れなかったスコアがあれば送信を始める
+ */
+void ScoreUploadQueue::start()
+{
+    this->prepare_spool_dir();
+    if (!list_entries(this->state->spool_dir).empty()) {
+        this->launch();
+    }
+}
+
+/*!
+ * @brief スコアを送信待ちに加える
+ * @param score 送信内容
+ * @return スプールディレクトリに保存できたらtrue
+ * @details 書き込み途中のファイルを送らないよう、別名で書き込んでから改名する.
+ */
+bool ScoreUploadQueue::enqueue(std::string_view score)
+{
+    this->prepare_spool_dir();
+    const auto &spool_dir = this->state->spool_dir;
+    std::error_code ec;
+    std::filesystem::create_directories(spool_dir, ec);
+
+    const auto now = static_cast<long long>(std::time(nullptr));
+    std::filesystem::path path;
+    for (auto serial = 0; path.empty() || std::filesystem::exists(path, ec); serial++) {
+        path = spool_dir / format("%020lld-%03d%s", now, serial, ENTRY_EXTENSION);
+    }
+
+    auto writing_path = path;
+    writing_path.replace_extension(WRITING_EXTENSION);
+    {
+        std::ofstream ofs(writing_path, std::ios::binary);
+        ofs.write(score.data(), score.length());
+        ofs.close();
+        if (!ofs) {
+            std::filesystem::remove(writing_path, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(writing_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(writing_path, ec);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        this->state->has_new_entry = true;
+    }
+
+    this->state->cv.notify_all();
+    this->launch();
+    return true;
+}
+
+/*!
+ * @brief 送信を打ち切って送信スレッドを終える
+ * @details
+ * 送信中なら SHUTDOWN_WAIT まで完了を待ち、それでも終わらなければ通信を打ち切る.
+ * 接続待ちは打ち切れないため、STOP_WAIT 以内にスレッドが終わらなければ切り離す.
+ * 送れなかったスコアはスプールに残り、次回の起動時に送る.
+ */
+void ScoreUploadQueue::shutdown()
+{
+    if (!this->worker.joinable()) {
+        return;
+    }
+
+    auto &state = *this->state;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait_for(lock, SHUTDOWN_WAIT, [&state] { return !state.is_sending && !state.has_new_entry; });
+    state.is_stopping = true;
+    if (state.client) {
+        state.client->stop();
+    }
+
+    state.cv.notify_all();
+    const auto is_finished = state.cv.wait_for(lock, STOP_WAIT, [&state] { return !state.is_running; });
+    lock.unlock();
+    if (is_finished) {
+        this->worker.join();
+    } else {
+        this->worker.detach();
+    }
+}
+
+void ScoreUploadQueue::prepare_spool_dir()
+{
+    if (this->state->spool_dir.empty()) {
+        this->state->spool_dir = path_build(ANGBAND_DIR_USER, SPOOL_DIR_NAME);
+    }
+}
+
+void ScoreUploadQueue::launch()
+{
+    if (this->worker.joinable()) {
+        return;
+    }
+
+    this->state->is_running = true;
+    this->worker = std::thread(run_upload, this->state);
+}
+#endif
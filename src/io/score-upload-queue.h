@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include "system/angband.h"
+
+#ifdef WORLD_SCORE
+#include <memory>
+#include <string_view>
+#include <thread>
+
+struct ScoreUploadState;
+
+/*!
+ * @brief スコアサーバへの送信待ちキュー
+ * @details
+ * 送信内容は1件ずつスプールディレクトリ (ユーザディレクトリの score-spool) にファイルとして保存し、
+ * バックグラウンドのスレッドが古い順に送信する. 送信に成功したファイルは削除し、
+ * 失敗した時は間隔を空けて再送する. 終了時までに送れなかったファイルは次回の起動時に送る.
+ * 環境変数 ANGBAND_SCORE_SERVER で送信先のホストを差し替えられる (例: http://127.0.0.1:8080).
+ */
+class ScoreUploadQueue {
+public:
+    ScoreUploadQueue(const ScoreUploadQueue &) = delete;
+    ScoreUploadQueue(ScoreUploadQueue &&) = delete;
+    ScoreUploadQueue &operator=(const ScoreUploadQueue &) = delete;
+    ScoreUploadQueue &operator=(ScoreUploadQueue &&) = delete;
+    ~ScoreUploadQueue();
+
+    static ScoreUploadQueue &get_instance();
+
+    void start();
+    bool enqueue(std::string_view score);
+    void shutdown();
+
+private:
+    ScoreUploadQueue();
+
+    static ScoreUploadQueue instance;
+
+    std::shared_ptr<ScoreUploadState> state; //!< 送信スレッドと共有する状態
+    std::thread worker{};
+
+    void prepare_spool_dir();
+    void launch();
+};
+#endif
@@ -92,7 +92,7 @@ void do_cmd_knowledge_artifacts(PlayerType *player_ptr)
     std::vector<FixedArtifactId> whats(known_list.begin(), known_list.end());
 
     uint16_t why = 3;
-    ang_sort(player_ptr, whats.data(), &why, whats.size(), ang_sort_art_comp, ang_sort_art_swap);
+    sort_artifact_ids(whats, why);
     for (auto a_idx : whats) {
         const auto &artifact = ArtifactsInfo::get_instance().get_artifact(a_idx);
         constexpr auto unknown_art = _("未知の伝説のアイテム", "Unknown Artifact");
@@ -325,8 +325,7 @@ void do_cmd_knowledge_quests(PlayerType *player_ptr)
     for (const auto &[q_idx, quest] : quest_list) {
         quest_numbers.push_back(q_idx);
     }
-    int dummy;
-    ang_sort(player_ptr, quest_numbers.data(), &dummy, quest_numbers.size(), ang_sort_comp_quest_num, ang_sort_swap_quest_num);
+    sort_quest_ids(quest_numbers);
 
     do_cmd_knowledge_quests_current(player_ptr, fff);
     fputc('\n', fff);
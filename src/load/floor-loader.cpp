@@ -5,8 +5,6 @@
 #include "game-option/birth-options.h"
 #include "grid/feature.h"
 #include "grid/grid.h"
-#include "io/files-util.h"
-#include "io/uid-checker.h"
 #include "load/angband-version-comparer.h"
 #include "load/item/item-loader-factory.h"
 #include "load/load-util.h"
@@ -25,10 +23,9 @@
 #include "system/item-entity.h"
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
-#include "term/z-form.h"
-#include "util/angband-files.h"
 #include "world/world-object.h"
 #include "world/world.h"
+#include <vector>
 
 /*!
  * @brief 保存されたフロアを読み込む / Read the saved floor
@@ -100,17 +97,24 @@ errr rd_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
     auto limit = rd_u16b();
     std::vector<grid_template_type> templates(limit);
 
-    for (auto &ct_ref : templates) {
-        ct_ref.info = rd_u16b();
-        if (h_older_than(1, 7, 0, 2)) {
+    if (h_older_than(1, 7, 0, 2)) {
+        for (auto &ct_ref : templates) {
+            ct_ref.info = rd_u16b();
             ct_ref.feat = rd_byte();
             ct_ref.mimic = rd_byte();
-        } else {
-            ct_ref.feat = rd_s16b();
-            ct_ref.mimic = rd_s16b();
+            ct_ref.special = rd_s16b();
+        }
+    } else {
+        // info, feat, mimic, special の4つの16bit値が並んでいるので、まとめて読み込む
+        std::vector<uint16_t> values(templates.size() * 4);
+        rd_u16b_array(values);
+        for (size_t i = 0; i < templates.size(); i++) {
+            auto &ct_ref = templates[i];
+            ct_ref.info = values[i * 4];
+            ct_ref.feat = static_cast<int16_t>(values[i * 4 + 1]);
+            ct_ref.mimic = static_cast<int16_t>(values[i * 4 + 2]);
+            ct_ref.special = static_cast<int16_t>(values[i * 4 + 3]);
         }
-
-        ct_ref.special = rd_s16b();
     }
 
     POSITION ymax = floor_ptr->height;
@@ -248,6 +252,8 @@ static bool load_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
  * @param sf_ptr 保存フロア読み込み先
  * @param mode オプション
  * @return 成功したらtrue
+ * @details save_floor() が saved_floor_images に保持したデータから読み込む.
+ * SLF_NO_KILL が指定されていなければ、読み込んだデータは破棄する.
  */
 bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode)
 {
@@ -267,6 +273,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
 #endif
 
     FILE *old_fff = nullptr;
+    LoadingSavefileBuffer old_buffer;
     byte old_xor_byte = 0;
     uint32_t old_v_check = 0;
     uint32_t old_x_check = 0;
@@ -277,6 +284,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     uint32_t old_loading_savefile_version = 0;
     if (mode & SLF_SECOND) {
         old_fff = loading_savefile;
+        old_buffer = std::move(loading_savefile_buffer);
         old_xor_byte = load_xor_byte;
         old_v_check = v_check;
         old_x_check = x_check;
@@ -287,37 +295,24 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
         old_loading_savefile_version = loading_savefile_version;
     }
 
-    auto floor_savefile = savefile.string();
-    char ext[32];
-    strnfmt(ext, sizeof(ext), ".F%02d", (int)sf_ptr->savefile_id);
-    floor_savefile.append(ext);
-
-    safe_setuid_grab();
-    loading_savefile = angband_fopen(floor_savefile, FileOpenMode::READ, true);
-    safe_setuid_drop();
-
-    bool is_save_successful = true;
-    if (!loading_savefile) {
-        is_save_successful = false;
+    auto &image = saved_floor_images[sf_ptr->savefile_id];
+    auto bytes = image.restore();
+    if (!(mode & SLF_NO_KILL)) {
+        image.clear();
     }
 
+    bool is_save_successful = bytes.has_value();
     if (is_save_successful) {
+        loading_savefile = nullptr;
+        loading_savefile_buffer.bytes = std::move(*bytes);
+        loading_savefile_buffer.pos = 0;
         is_save_successful = load_floor_aux(player_ptr, sf_ptr);
-        if (ferror(loading_savefile)) {
-            is_save_successful = false;
-        }
-
-        angband_fclose(loading_savefile);
-        safe_setuid_grab();
-        if (!(mode & SLF_NO_KILL)) {
-            (void)fd_kill(floor_savefile);
-        }
-
-        safe_setuid_drop();
+        loading_savefile_buffer = {};
     }
 
     if (mode & SLF_SECOND) {
         loading_savefile = old_fff;
+        loading_savefile_buffer = std::move(old_buffer);
         load_xor_byte = old_xor_byte;
         v_check = old_v_check;
         x_check = old_x_check;
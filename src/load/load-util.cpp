@@ -2,8 +2,10 @@
 #include "locale/japanese.h"
 #include "term/gameterm.h"
 #include "term/screen-processor.h"
+#include <type_traits>
 
 FILE *loading_savefile;
+LoadingSavefileBuffer loading_savefile_buffer;
 uint32_t loading_savefile_version;
 byte load_xor_byte; // Old "encryption" byte.
 uint32_t v_check = 0L; // Simple "checksum" on the actual values.
@@ -35,6 +37,58 @@ void load_note(std::string_view msg)
     term_fresh();
 }
 
+/*!
+ * @brief ロード中のセーブファイルの全内容をメモリに読み込む
+ * @details loading_savefile を開いた直後に呼ぶこと. 以降の読み込みはすべてメモリ上から行う.
+ * 読み込みエラーは従来通り ferror(loading_savefile) で検出できる.
+ */
+void read_loading_savefile()
+{
+    constexpr size_t chunk_size = 64 * 1024;
+    auto &bytes = loading_savefile_buffer.bytes;
+    bytes.clear();
+    loading_savefile_buffer.pos = 0;
+    while (true) {
+        const auto size = bytes.size();
+        bytes.resize(size + chunk_size);
+        const auto read_size = fread(bytes.data() + size, 1, chunk_size, loading_savefile);
+        bytes.resize(size + read_size);
+        if (read_size < chunk_size) {
+            break;
+        }
+    }
+}
+
+/*!
+ * @brief メモリ上のセーブファイルから指定バイト数をまとめて復号する
+ * @param buf 復号したバイト列の格納先. nullptr なら読み捨てる
+ * @param n 読み込むバイト数
+ * @details ファイル終端を越えた分は、getc() が EOF を返していた頃と同じく 0xFF を読んだものとして扱う.
+ */
+static void sf_get_bytes(byte *buf, size_t n)
+{
+    auto &[bytes, pos] = loading_savefile_buffer;
+    const auto available = pos < bytes.size() ? std::min(n, bytes.size() - pos) : 0;
+    auto xor_byte = load_xor_byte;
+    auto value_sum = v_check;
+    auto encoded_sum = x_check;
+    for (size_t i = 0; i < n; i++) {
+        const byte c = i < available ? bytes[pos + i] : 0xFF;
+        const byte v = c ^ xor_byte;
+        xor_byte = c;
+        value_sum += v;
+        encoded_sum += c;
+        if (buf != nullptr) {
+            buf[i] = v;
+        }
+    }
+
+    pos += n;
+    load_xor_byte = xor_byte;
+    v_check = value_sum;
+    x_check = encoded_sum;
+}
+
 /*!
  * @brief ロードファイルポインタから1バイトを読み込む
  * @return 読み込んだバイト値
@@ -44,12 +98,8 @@ void load_note(std::string_view msg)
  */
 byte sf_get(void)
 {
-    byte c = getc(loading_savefile) & 0xFF;
-    byte v = c ^ load_xor_byte;
-    load_xor_byte = c;
-
-    v_check += v;
-    x_check += load_xor_byte;
+    byte v;
+    sf_get_bytes(&v, 1);
     return v;
 }
 
@@ -74,8 +124,10 @@ byte rd_byte()
  */
 uint16_t rd_u16b()
 {
-    uint16_t val = sf_get();
-    val |= (static_cast<uint16_t>(sf_get()) << 8);
+    byte buf[2];
+    sf_get_bytes(buf, sizeof(buf));
+    uint16_t val = buf[0];
+    val |= (static_cast<uint16_t>(buf[1]) << 8);
 
     return val;
 }
@@ -93,10 +145,12 @@ int16_t rd_s16b()
  */
 uint32_t rd_u32b()
 {
-    uint32_t val = sf_get();
-    val |= (static_cast<uint32_t>(sf_get()) << 8);
-    val |= (static_cast<uint32_t>(sf_get()) << 16);
-    val |= (static_cast<uint32_t>(sf_get()) << 24);
+    byte buf[4];
+    sf_get_bytes(buf, sizeof(buf));
+    uint32_t val = buf[0];
+    val |= (static_cast<uint32_t>(buf[1]) << 8);
+    val |= (static_cast<uint32_t>(buf[2]) << 16);
+    val |= (static_cast<uint32_t>(buf[3]) << 24);
 
     return val;
 }
@@ -109,6 +163,64 @@ int32_t rd_s32b()
     return static_cast<int32_t>(rd_u32b());
 }
 
+/*!
+ * @brief メモリ上のセーブファイルからリトルエンディアンの整数列をまとめて読み込む
+ * @param values 読み込んだ値の格納先
+ * @details 全要素分のバイト列を1回で復号してから、要素毎にホストのバイト順へ並べ直す.
+ */
+template <typename T>
+static void rd_integer_array(std::span<T> values)
+{
+    auto *bytes = reinterpret_cast<byte *>(values.data());
+    sf_get_bytes(bytes, values.size_bytes());
+    using U = std::make_unsigned_t<T>;
+    for (auto &value : values) {
+        const auto *value_bytes = reinterpret_cast<const byte *>(&value);
+        U val = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            val |= static_cast<U>(static_cast<U>(value_bytes[i]) << (i * 8));
+        }
+
+        value = static_cast<T>(val);
+    }
+}
+
+/*!
+ * @brief ロードファイルポインタからバイト列をまとめて読み込む
+ * @param values 読み込んだ値の格納先
+ */
+void rd_byte_array(std::span<byte> values)
+{
+    sf_get_bytes(values.data(), values.size());
+}
+
+/*!
+ * @brief ロードファイルポインタから符号なし16bit値の列をまとめて読み込む
+ * @param values 読み込んだ値の格納先
+ */
+void rd_u16b_array(std::span<uint16_t> values)
+{
+    rd_integer_array(values);
+}
+
+/*!
+ * @brief ロードファイルポインタから符号つき16bit値の列をまとめて読み込む
+ * @param values 読み込んだ値の格納先
+ */
+void rd_s16b_array(std::span<int16_t> values)
+{
+    rd_integer_array(values);
+}
+
+/*!
+ * @brief ロードファイルポインタから符号なし32bit値の列をまとめて読み込む
+ * @param values 読み込んだ値の格納先
+ */
+void rd_u32b_array(std::span<uint32_t> values)
+{
+    rd_integer_array(values);
+}
+
 /*!
  * @brief ロードファイルポインタから文字列を読み込んでポインタに渡す / Hack -- read a string
  * @param str 読み込みポインタ
@@ -176,8 +288,8 @@ void rd_string(std::string &str, int max)
  */
 void strip_bytes(int n)
 {
-    while (n-- > 0) {
-        (void)rd_byte();
+    if (n > 0) {
+        sf_get_bytes(nullptr, n);
     }
 }
 
@@ -4,10 +4,21 @@
 
 #include <algorithm>
 #include <bitset>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
+
+/*!
+ * @brief メモリ上に読み込んだロード中のセーブファイル
+ */
+struct LoadingSavefileBuffer {
+    std::vector<byte> bytes; /*!< ファイルの全内容 (復号前) */
+    size_t pos = 0; /*!< 次に読み込む位置 */
+};
 
 extern FILE *loading_savefile;
+extern LoadingSavefileBuffer loading_savefile_buffer;
 extern uint32_t loading_savefile_version;
 extern byte load_xor_byte;
 extern uint32_t v_check;
@@ -15,6 +26,7 @@ extern uint32_t x_check;
 extern byte kanji_code;
 
 void load_note(std::string_view msg);
+void read_loading_savefile();
 byte sf_get(void);
 bool rd_bool();
 byte rd_byte();
@@ -22,6 +34,10 @@ uint16_t rd_u16b();
 int16_t rd_s16b();
 uint32_t rd_u32b();
 int32_t rd_s32b();
+void rd_byte_array(std::span<byte> values);
+void rd_u16b_array(std::span<uint16_t> values);
+void rd_s16b_array(std::span<int16_t> values);
+void rd_u32b_array(std::span<uint32_t> values);
 void rd_string(char *str, int max);
 void rd_string(std::string &str, int max);
 void strip_bytes(int n);
@@ -274,6 +274,7 @@ static errr rd_savefile(PlayerType *player_ptr)
         return -1;
     }
 
+    read_loading_savefile();
     try {
         auto err = exe_reading_savefile(player_ptr);
         if (ferror(loading_savefile)) {
@@ -281,10 +282,12 @@ static errr rd_savefile(PlayerType *player_ptr)
         }
 
         angband_fclose(loading_savefile);
+        loading_savefile_buffer = {};
         return err;
     } catch (SaveDataNotSupportedException const &e) {
         msg_print(e.what());
         angband_fclose(loading_savefile);
+        loading_savefile_buffer = {};
         return 1;
     }
 }
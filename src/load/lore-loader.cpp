@@ -13,6 +13,8 @@
 #include "system/monster-race-info.h"
 #include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
+#include <array>
+#include <span>
 
 static void migrate_old_feature_flags(MonsterRaceInfo *r_ptr, BIT_FLAGS old_flags)
 {
@@ -272,9 +274,11 @@ static void rd_r_feature_flags(MonsterRaceInfo *r_ptr)
  */
 static void rd_lore(MonsterRaceInfo *r_ptr, const MonsterRaceId r_idx)
 {
-    r_ptr->r_sights = rd_s16b();
-    r_ptr->r_deaths = rd_s16b();
-    r_ptr->r_pkills = rd_s16b();
+    std::array<int16_t, 3> counts{};
+    rd_s16b_array(counts);
+    r_ptr->r_sights = counts[0];
+    r_ptr->r_deaths = counts[1];
+    r_ptr->r_pkills = counts[2];
 
     if (h_older_than(1, 7, 0, 5)) {
         r_ptr->r_akills = r_ptr->r_pkills;
@@ -299,14 +303,13 @@ static void rd_lore(MonsterRaceInfo *r_ptr, const MonsterRaceId r_idx)
     strip_bytes(1);
     r_ptr->r_cast_spell = rd_byte();
 
-    r_ptr->r_blows[0] = rd_byte();
-    r_ptr->r_blows[1] = rd_byte();
-    r_ptr->r_blows[2] = rd_byte();
-    r_ptr->r_blows[3] = rd_byte();
+    rd_byte_array(std::span(r_ptr->r_blows).first<4>());
 
-    r_ptr->r_flags1 = rd_u32b();
-    r_ptr->r_flags2 = rd_u32b();
-    r_ptr->r_flags3 = rd_u32b();
+    std::array<uint32_t, 3> r_flags{};
+    rd_u32b_array(r_flags);
+    r_ptr->r_flags1 = r_flags[0];
+    r_ptr->r_flags2 = r_flags[1];
+    r_ptr->r_flags3 = r_flags[2];
     migrate_old_aura_flags(r_ptr);
     rd_r_ability_flags(r_ptr, r_idx);
     rd_r_aura_flags(r_ptr);
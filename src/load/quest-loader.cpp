@@ -16,6 +16,7 @@
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
 #include "util/enum-converter.h"
+#include <array>
 
 errr load_town(void)
 {
@@ -43,8 +44,10 @@ std::tuple<uint16_t, byte> load_quest_info()
 
 static void load_quest_completion(QuestType *q_ptr)
 {
-    q_ptr->status = i2enum<QuestStatusType>(rd_s16b());
-    q_ptr->level = rd_s16b();
+    std::array<int16_t, 2> values{};
+    rd_s16b_array(values);
+    q_ptr->status = i2enum<QuestStatusType>(values[0]);
+    q_ptr->level = values[1];
 
     if (h_older_than(1, 0, 6)) {
         q_ptr->complev = 0;
@@ -61,16 +64,18 @@ static void load_quest_completion(QuestType *q_ptr)
 
 static void load_quest_details(PlayerType *player_ptr, QuestType *q_ptr, const QuestId loading_quest_index)
 {
-    q_ptr->cur_num = rd_s16b();
-    q_ptr->max_num = rd_s16b();
-    q_ptr->type = i2enum<QuestKindType>(rd_s16b());
+    std::array<int16_t, 5> values{};
+    rd_s16b_array(values);
+    q_ptr->cur_num = values[0];
+    q_ptr->max_num = values[1];
+    q_ptr->type = i2enum<QuestKindType>(values[2]);
 
-    q_ptr->r_idx = i2enum<MonsterRaceId>(rd_s16b());
+    q_ptr->r_idx = i2enum<MonsterRaceId>(values[3]);
     if ((q_ptr->type == QuestKindType::RANDOM) && !MonsterRace(q_ptr->r_idx).is_valid()) {
         auto &quest_list = QuestList::get_instance();
         determine_random_questor(player_ptr, &quest_list[loading_quest_index]);
     }
-    q_ptr->reward_artifact_idx = i2enum<FixedArtifactId>(rd_s16b());
+    q_ptr->reward_artifact_idx = i2enum<FixedArtifactId>(values[4]);
     if (q_ptr->has_reward()) {
         q_ptr->get_reward().gen_flags.set(ItemGenerationTraitType::QUESTITEM);
     }
@@ -129,12 +134,7 @@ static bool is_loadable_quest(const QuestId q_idx, const byte max_rquests_load)
         return false;
     }
 
-    strip_bytes(2);
-    strip_bytes(2);
-    strip_bytes(2);
-    strip_bytes(2);
-    strip_bytes(2);
-    strip_bytes(1);
+    strip_bytes(11);
     return false;
 }
 
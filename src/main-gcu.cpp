@@ -206,6 +206,15 @@ static rect_t rect(int x, int y, int cx, int cy)
     return r;
 }
 
+/**
+ * A cell drawn by the term hooks but not yet sent to curses
+ */
+struct gcu_cell {
+    byte a;
+    char c;
+    bool is_dirty;
+};
+
 /**
  * Information about a term
  */
@@ -213,6 +222,15 @@ struct term_data {
     term_type t;
     rect_t r;
     WINDOW *win;
+
+    /* Cells drawn since the last flush, sent to curses in runs per row and color */
+    std::vector<gcu_cell> cells;
+    std::vector<int> dirty_x1;
+    std::vector<int> dirty_x2;
+
+    /* Cursor position requested since the last flush */
+    int cursor_x;
+    int cursor_y;
 };
 
 /* Max number of windows on screen */
@@ -267,7 +285,9 @@ static term_data data[MAX_TERM_DATA];
 #include <sys/types.h>
 #endif
 
+#include <cerrno>
 #include <locale.h>
+#include <vector>
 
 /*
  * XXX XXX Hack -- POSIX uses "O_NONBLOCK" instead of "O_NDELAY"
@@ -947,6 +967,380 @@ static errr game_term_xtra_gcu_react(void)
     return 0;
 }
 
+/*
+ * Output statistics, enabled by "-- -stat <file>"
+ *
+ * While curses updates the screen, its output is captured in a temporary
+ * file, counted and then copied to the terminal.
+ */
+static FILE *stat_fff = nullptr;
+static FILE *stat_capture = nullptr;
+static int stat_tty_fd = -1;
+static int stat_frame = 0;
+static int stat_runs = 0;
+
+/*
+ * Attribute of a run of spaces only, drawn like erased cells
+ */
+#define FRAME_ATTR_NORMAL (-1)
+
+/*
+ * Longest gap of untouched spaces filled to join two runs of one color
+ */
+#define FRAME_MAX_GAP 4
+
+/*
+ * Some windows have been refreshed, but the screen is not updated yet
+ */
+static bool is_update_pending = false;
+
+/*
+ * Close the statistics file and the capture buffer
+ */
+static void stat_close(void)
+{
+    if (stat_fff) {
+        fclose(stat_fff);
+        stat_fff = nullptr;
+    }
+
+    if (stat_capture) {
+        fclose(stat_capture);
+        stat_capture = nullptr;
+    }
+
+    if (stat_tty_fd >= 0) {
+        (void)close(stat_tty_fd);
+        stat_tty_fd = -1;
+    }
+}
+
+/*
+ * Open the statistics file and the capture buffer
+ */
+static void stat_init(concptr path)
+{
+    stat_fff = fopen(path, "w");
+    stat_capture = tmpfile();
+    stat_tty_fd = dup(STDOUT_FILENO);
+    if (stat_fff && stat_capture && (stat_tty_fd >= 0)) {
+        return;
+    }
+
+    plog(format("Cannot write output statistics to %s", path).data());
+    stat_close();
+}
+
+/*
+ * Point the standard output at the given file descriptor
+ */
+static bool stat_redirect(int fd)
+{
+    while (dup2(fd, STDOUT_FILENO) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Give up the statistics and send the output to the terminal directly
+ */
+static void stat_abort(concptr reason)
+{
+    plog(format("Output statistics stopped: %s", reason).data());
+    stat_close();
+}
+
+/*
+ * Let curses update the screen, counting the bytes it writes
+ */
+static void stat_doupdate(void)
+{
+    const auto fd = fileno(stat_capture);
+    (void)fflush(stdout);
+    if (!stat_redirect(fd)) {
+        stat_abort("cannot capture the output");
+        (void)doupdate();
+        return;
+    }
+
+    (void)doupdate();
+    (void)fflush(stdout);
+    if (!stat_redirect(stat_tty_fd)) {
+        quit("Cannot restore the standard output");
+    }
+
+    const auto size = lseek(fd, 0, SEEK_CUR);
+    (void)lseek(fd, 0, SEEK_SET);
+    char buf[4096];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        for (auto *p = buf; len > 0;) {
+            const auto written = write(STDOUT_FILENO, p, len);
+            if (written <= 0) {
+                break;
+            }
+
+            p += written;
+            len -= written;
+        }
+    }
+
+    if ((ftruncate(fd, 0) != 0) || (lseek(fd, 0, SEEK_SET) != 0)) {
+        stat_abort("cannot reset the capture buffer");
+        return;
+    }
+
+    fprintf(stat_fff, "frame %d: %ld bytes, %d runs\n", ++stat_frame, static_cast<long>(size), stat_runs);
+    (void)fflush(stat_fff);
+    stat_runs = 0;
+}
+
+/*
+ * Send the refreshed windows to the terminal at once
+ */
+static void update_screen(void)
+{
+    if (!is_update_pending) {
+        return;
+    }
+
+    is_update_pending = false;
+    if (stat_fff) {
+        stat_doupdate();
+        return;
+    }
+
+    (void)doupdate();
+}
+
+/*
+ * Prepare the cells of a frame
+ */
+static void frame_init(term_data *td, int rows, int cols)
+{
+    td->cells.assign(rows * cols, { TERM_WHITE, ' ', false });
+    td->dirty_x1.assign(rows, cols);
+    td->dirty_x2.assign(rows, -1);
+    td->cursor_x = -1;
+    td->cursor_y = -1;
+}
+
+/*
+ * Forget the cells drawn since the last flush
+ */
+static void frame_discard(term_data *td)
+{
+    const auto wid = td->t.wid;
+    for (auto y = 0; y < td->t.hgt; y++) {
+        for (auto x = td->dirty_x1[y]; x <= td->dirty_x2[y]; x++) {
+            td->cells[y * wid + x].is_dirty = false;
+        }
+
+        td->dirty_x1[y] = wid;
+        td->dirty_x2[y] = -1;
+    }
+}
+
+/*
+ * Remember a cell to draw at the next flush
+ */
+static void frame_put(term_data *td, int x, int y, byte a, char c)
+{
+    if ((x < 0) || (x >= td->t.wid) || (y < 0) || (y >= td->t.hgt)) {
+        return;
+    }
+
+    td->cells[y * td->t.wid + x] = { a, c, true };
+    td->dirty_x1[y] = std::min(td->dirty_x1[y], x);
+    td->dirty_x2[y] = std::max(td->dirty_x2[y], x);
+}
+
+/*
+ * The attribute bits which decide how a cell is drawn
+ */
+static int frame_attr(byte a)
+{
+#ifdef USE_NCURSES_ACS
+    return a & 0x1F;
+#else
+    return a & 0x0F;
+#endif
+}
+
+/*
+ * A space looks the same in every color, so it may join any text run
+ */
+static bool frame_is_blank(const gcu_cell &cell)
+{
+    return (cell.c == ' ') && !(frame_attr(cell.a) & 0x10);
+}
+
+/*
+ * Draw a run of characters sharing one attribute
+ */
+static void frame_draw_run(term_data *td, int x, int y, int attr, const char *s, int n)
+{
+    stat_runs++;
+    wmove(td->win, y, x);
+
+#ifdef USE_NCURSES_ACS
+    /* Draw some graphical chars (blocks, lines etc) */
+    if ((attr != FRAME_ATTR_NORMAL) && (attr & 0x10)) {
+#ifdef A_COLOR
+        wattrset(td->win, colortable[attr & 0x0F]);
+#endif
+        for (auto i = 0; i < n; i++) {
+            waddch(td->win, acs_map[(int)s[i]]);
+        }
+
+        wattrset(td->win, WA_NORMAL);
+        return;
+    }
+#endif
+
+#ifdef A_COLOR
+    if (can_use_color) {
+        wattrset(td->win, (attr == FRAME_ATTR_NORMAL) ? WA_NORMAL : colortable[attr & 0x0F]);
+    }
+#endif
+
+#ifdef JP
+    char text[1024];
+    int text_len = euc_to_utf8(s, n, text, sizeof(text));
+    if (text_len < 0) {
+        return;
+    }
+#endif
+    waddnstr(td->win, _(text, s), _(text_len, n));
+}
+
+/*
+ * Count the untouched spaces between a text run and more text of its color
+ *
+ * Redrawing such a short gap in the color of the run is cheaper than
+ * switching colors twice around it.
+ */
+static int frame_blank_gap(term_data *td, int x, int y, int limit, int attr)
+{
+    if ((attr == FRAME_ATTR_NORMAL) || (attr & 0x10)) {
+        return 0;
+    }
+
+    const auto *row = &td->cells[y * td->t.wid];
+    for (auto gap = 0; (gap <= FRAME_MAX_GAP) && (x + gap < limit); gap++) {
+        const auto &cell = row[x + gap];
+        if (cell.is_dirty) {
+            return (gap > 0) && !frame_is_blank(cell) && (frame_attr(cell.a) == attr) ? gap : 0;
+        }
+
+        if ((mvwinch(td->win, y, x + gap) & A_CHARTEXT) != ' ') {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Send the cells drawn during a frame to the curses window
+ *
+ * Adjacent cells are gathered into runs of one attribute per row.
+ * Spaces join the text around them, and runs of spaces only are drawn
+ * like erased cells, so that curses switches colors as rarely as possible.
+ * Spaces reaching the right edge are cleared at once.
+ */
+static void frame_flush(term_data *td)
+{
+    const auto wid = td->t.wid;
+    std::string run;
+    for (auto y = 0; y < td->t.hgt; y++) {
+        const auto x1 = td->dirty_x1[y];
+        const auto x2 = td->dirty_x2[y];
+        if (x1 > x2) {
+            continue;
+        }
+
+        auto *row = &td->cells[y * wid];
+        auto clear_x = x2 + 1;
+        if (clear_x == wid) {
+            while ((clear_x > x1) && row[clear_x - 1].is_dirty && frame_is_blank(row[clear_x - 1])) {
+                clear_x--;
+            }
+        }
+
+        auto x = x1;
+        while (x < clear_x) {
+            if (!row[x].is_dirty) {
+                x++;
+                continue;
+            }
+
+            /* Leading spaces take the color of the text after them */
+            auto attr = FRAME_ATTR_NORMAL;
+            for (auto i = x; (i < clear_x) && row[i].is_dirty; i++) {
+                if (!frame_is_blank(row[i])) {
+                    const auto next_attr = frame_attr(row[i].a);
+                    if ((i == x) || !(next_attr & 0x10)) {
+                        attr = next_attr;
+                    }
+
+                    break;
+                }
+            }
+
+            const auto start = x;
+            run.clear();
+            while (x < clear_x) {
+                if (!row[x].is_dirty) {
+                    const auto gap = frame_blank_gap(td, x, y, clear_x, attr);
+                    if (gap == 0) {
+                        break;
+                    }
+
+                    run.append(gap, ' ');
+                    x += gap;
+                    continue;
+                }
+
+                const auto is_matched = frame_is_blank(row[x]) ? ((attr == FRAME_ATTR_NORMAL) || !(attr & 0x10)) : (frame_attr(row[x].a) == attr);
+                if (!is_matched) {
+                    break;
+                }
+
+                run.push_back(row[x].c);
+                row[x].is_dirty = false;
+                x++;
+            }
+
+            frame_draw_run(td, start, y, attr, run.data(), run.length());
+        }
+
+        if (clear_x <= x2) {
+            wmove(td->win, y, clear_x);
+            wclrtoeol(td->win);
+            for (x = clear_x; x < wid; x++) {
+                row[x].is_dirty = false;
+            }
+        }
+
+        td->dirty_x1[y] = wid;
+        td->dirty_x2[y] = -1;
+    }
+
+    if (td->cursor_x >= 0) {
+        wmove(td->win, td->cursor_y, td->cursor_x);
+        td->cursor_x = -1;
+        td->cursor_y = -1;
+    }
+
+    (void)wnoutrefresh(td->win);
+    is_update_pending = true;
+}
+
 /*
  * Handle a "special request"
  */
@@ -958,6 +1352,7 @@ static errr game_term_xtra_gcu(int n, int v)
     switch (n) {
     /* Clear screen */
     case TERM_XTRA_CLEAR:
+        frame_discard(td);
         touchwin(td->win);
         (void)werase(td->win);
         return 0;
@@ -971,8 +1366,13 @@ static errr game_term_xtra_gcu(int n, int v)
         return game_term_xtra_gcu_sound(v);
 
     /* Flush the Curses buffer */
+    /* Sub-windows are sent to the terminal together with the main window or before waiting for keys */
     case TERM_XTRA_FRESH:
-        (void)wrefresh(td->win);
+        frame_flush(td);
+        if (td == &data[0]) {
+            update_screen();
+        }
+
         return 0;
 
     /* Change the cursor visibility */
@@ -982,14 +1382,17 @@ static errr game_term_xtra_gcu(int n, int v)
 
     /* Suspend/Resume curses */
     case TERM_XTRA_ALIVE:
+        update_screen();
         return game_term_xtra_gcu_alive(v);
 
     /* Process events */
     case TERM_XTRA_EVENT:
+        update_screen();
         return game_term_xtra_gcu_event(v);
 
     /* Flush events */
     case TERM_XTRA_FLUSH:
+        update_screen();
         while (!game_term_xtra_gcu_event(false)) {
             ;
         }
@@ -997,6 +1400,7 @@ static errr game_term_xtra_gcu(int n, int v)
 
     /* Delay */
     case TERM_XTRA_DELAY:
+        update_screen();
         usleep(1000 * v);
         return 0;
 
@@ -1017,8 +1421,9 @@ static errr game_term_curs_gcu(int x, int y)
 {
     term_data *td = (term_data *)(game_term->data);
 
-    /* Literally move the cursor */
-    wmove(td->win, y, x);
+    /* Move the cursor after the frame is drawn */
+    td->cursor_x = x;
+    td->cursor_y = y;
 
     /* Success */
     return 0;
@@ -1026,61 +1431,20 @@ static errr game_term_curs_gcu(int x, int y)
 
 /*
  * Erase a grid of space
- * Hack -- try to be "semi-efficient".
  */
 static errr game_term_wipe_gcu(int x, int y, int n)
 {
     term_data *td = (term_data *)(game_term->data);
 
-    /* Place cursor */
-    wmove(td->win, y, x);
-
-    /* Clear to end of line */
-    if (x + n >= td->t.wid) {
-        wclrtoeol(td->win);
-    }
-
-    /* Clear some characters */
-    else {
-        while (n-- > 0) {
-            waddch(td->win, ' ');
-        }
+    /* Remember the spaces */
+    for (auto i = 0; i < n; i++) {
+        frame_put(td, x + i, y, TERM_WHITE, ' ');
     }
 
     /* Success */
     return 0;
 }
 
-#ifdef USE_NCURSES_ACS
-/*
- * this function draws some ACS characters on the screen
- * for DOS-based users: these are the graphical chars (blocks, lines etc)
- *
- * unix-gurus: before you start adding other attributes like A_REVERSE
- * think hard about how map_info() in cave.c should handle the color
- * of something that we here draw in reverse. It's not so simple, alas.
- */
-static void game_term_acs_text_gcu(int x, int y, int n, byte a, concptr s)
-{
-    term_data *td = (term_data *)(game_term->data);
-    int i;
-
-    /* position the cursor */
-    wmove(td->win, y, x);
-
-#ifdef A_COLOR
-    /* Set the color */
-    wattrset(td->win, colortable[a & 0x0F]);
-#endif
-
-    for (i = 0; i < n; i++) {
-        /* add acs_map of a */
-        waddch(td->win, acs_map[(int)s[i]]);
-    }
-    wattrset(td->win, WA_NORMAL);
-}
-#endif
-
 /*
  * Place some text on the screen using an attribute
  */
@@ -1088,34 +1452,10 @@ static errr game_term_text_gcu(int x, int y, int n, byte a, concptr s)
 {
     term_data *td = (term_data *)(game_term->data);
 
-#ifdef USE_NCURSES_ACS
-    /* do we have colors + 16 ? */
-    /* then call special routine for drawing special characters */
-    if (a & 0x10) {
-        game_term_acs_text_gcu(x, y, n, a, s);
-        return 0;
-    }
-#endif
-
-    /* Move the cursor and dump the string */
-    wmove(td->win, y, x);
-
-#ifdef A_COLOR
-    /* Set the color */
-    if (can_use_color) {
-        wattrset(td->win, colortable[a & 0x0F]);
+    /* Remember the text */
+    for (auto i = 0; i < n; i++) {
+        frame_put(td, x + i, y, a, s[i]);
     }
-#endif
-
-#ifdef JP
-    char text[1024];
-    int text_len = euc_to_utf8(s, n, text, sizeof(text));
-    if (text_len < 0) {
-        return -1;
-    }
-#endif
-    /* Add the text */
-    waddnstr(td->win, _(text, s), _(text_len, n));
 
     /* Success */
     return 0;
@@ -1146,6 +1486,7 @@ static errr term_data_init_gcu(term_data *td, int rows, int cols, int y, int x)
 
     /* Initialize the term */
     term_init(t, cols, rows, 256);
+    frame_init(td, rows, cols);
 
     /* Avoid the bottom right corner */
     t->icky_corner = true;
@@ -1246,9 +1587,12 @@ errr init_gcu(int argc, char *argv[])
     ANGBAND_DIR_XTRA_SOUND = path_build(ANGBAND_DIR_XTRA, "sound");
     keymap_norm_prepare();
     auto nobigscreen = false;
+    concptr stat_path = nullptr;
     for (auto i = 1; i < argc; i++) {
         if (prefix(argv[i], "-o")) {
             nobigscreen = true;
+        } else if (streq(argv[i], "-stat") && (i + 1 < argc)) {
+            stat_path = argv[++i];
         }
     }
 
@@ -1256,6 +1600,10 @@ errr init_gcu(int argc, char *argv[])
         return -1;
     }
 
+    if (stat_path) {
+        stat_init(stat_path);
+    }
+
     quit_aux = hook_quit;
     core_aux = hook_quit;
     if ((LINES < MAIN_TERM_MIN_ROWS) || (COLS < MAIN_TERM_MIN_COLS)) {
@@ -198,6 +198,7 @@ static void display_usage(const char *program)
     puts("  -mgcu    To use GCU (GNU Curses)");
     puts("  --       Sub options");
     puts("  -- -o    old subwindow layout (no bigscreen)");
+    puts("  -- -stat <file> Write bytes sent to the terminal per frame");
 #endif /* USE_GCU */
 
 #ifdef USE_CAP
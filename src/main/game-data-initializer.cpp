@@ -51,12 +51,15 @@ void init_other(PlayerType *player_ptr)
     auto *floor_ptr = player_ptr->current_floor_ptr;
     floor_ptr->o_list.assign(w_ptr->max_o_idx, {});
     floor_ptr->m_list.assign(w_ptr->max_m_idx, {});
+    floor_ptr->live_monster_indices.resize(w_ptr->max_m_idx);
+    floor_ptr->live_object_indices.resize(w_ptr->max_o_idx);
+    floor_ptr->found_item_index.resize(w_ptr->max_o_idx);
     for (auto &list : floor_ptr->mproc_list) {
         list.assign(w_ptr->max_m_idx, {});
     }
 
     max_dlv.assign(dungeons_info.size(), {});
-    floor_ptr->grid_array.assign(MAX_HGT, std::vector<grid_type>(MAX_WID));
+    floor_ptr->grid_array.resize(MAX_HGT, MAX_WID);
     init_gf_colors();
 
     macro__pat.assign(MACRO_MAX, {});
@@ -0,0 +1,773 @@
+﻿/*!
+ * @file info-cache.cpp
+ * @brief ゲームデータのバイナリキャッシュ処理定義
+ * @details
+ * lib/edit/ のテキストを解析した結果をユーザディレクトリの cache/ にそのまま書き出し、
+ * 次回起動時に元テキストと実行ファイルが同じであれば解析を省略して読み込む.
+ * キャッシュはメモリ上の表現をそのまま書き出すため、プラットフォーム間の互換性はない.
+ * lib/ は読み込み専用でインストールされることもあるため、lib/ 以下には書き出さない.
+ */
+
+#include "main/info-cache.h"
+#include "io/files-util.h"
+#include "main/angband-headers.h"
+#include "monster-race/monster-race.h"
+#include "object-enchant/object-ego.h"
+#include "player-info/class-info.h"
+#include "player/player-skill.h"
+#include "room/rooms-vault.h"
+#include "system/angband-version.h"
+#include "system/artifact-type-definition.h"
+#include "system/baseitem-info.h"
+#include "system/dungeon-info.h"
+#include "system/monster-race-info.h"
+#include "system/terrain-type-definition.h"
+#include "term/z-util.h"
+#include "util/angband-files.h"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#ifdef WINDOWS
+#include <windows.h>
+#endif
+
+namespace {
+
+/*!
+ * @brief キャッシュの書式番号
+ * @details キャッシュに書き出す構造体のメンバを変更した時は必ず増やすこと
+ */
+constexpr uint32_t INFO_CACHE_FORMAT = 1;
+
+/*!
+ * @brief キャッシュする構造体の大きさを検査するか
+ * @details 構造体の大きさはコンパイラと標準ライブラリに依存するため、64ビットの libstdc++ 環境でのみ検査する
+ */
+#if defined(__GLIBCXX__) && (__SIZEOF_POINTER__ == 8)
+constexpr auto CHECK_INFO_SIZE = true;
+#else
+constexpr auto CHECK_INFO_SIZE = false;
+#endif
+
+template <typename>
+struct is_vector : std::false_type {
+};
+
+template <typename T, typename Alloc>
+struct is_vector<std::vector<T, Alloc>> : std::true_type {
+};
+
+template <typename>
+struct is_map : std::false_type {
+};
+
+template <typename K, typename V, typename Compare, typename Alloc>
+struct is_map<std::map<K, V, Compare, Alloc>> : std::true_type {
+};
+
+template <typename>
+struct is_std_array : std::false_type {
+};
+
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {
+};
+
+template <typename>
+struct is_tuple : std::false_type {
+};
+
+template <typename... Ts>
+struct is_tuple<std::tuple<Ts...>> : std::true_type {
+};
+
+/*!
+ * @brief メモリ上の値をバイト列へ書き出す
+ */
+class InfoCacheWriter {
+public:
+    std::vector<byte> bytes;
+
+    void write_raw(const void *data, size_t size)
+    {
+        const auto *first = static_cast<const byte *>(data);
+        this->bytes.insert(this->bytes.end(), first, first + size);
+    }
+
+    template <typename T>
+    void field(T &value);
+};
+
+/*!
+ * @brief バイト列からメモリ上の値を復元する
+ * @details 範囲外の読み込みを検出したら failed を立て、以降の読み込みを全て無視する
+ */
+class InfoCacheReader {
+public:
+    InfoCacheReader(const std::vector<byte> &bytes, size_t pos)
+        : bytes(bytes)
+        , pos(pos)
+    {
+    }
+
+    bool failed = false;
+
+    bool read_raw(void *data, size_t size)
+    {
+        if (this->failed || (this->bytes.size() - this->pos < size)) {
+            this->failed = true;
+            return false;
+        }
+
+        std::memcpy(data, this->bytes.data() + this->pos, size);
+        this->pos += size;
+        return true;
+    }
+
+    bool is_end() const
+    {
+        return !this->failed && (this->pos == this->bytes.size());
+    }
+
+    template <typename T>
+    void field(T &value);
+
+private:
+    const std::vector<byte> &bytes;
+    size_t pos;
+};
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(TerrainState) == 48), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, TerrainState &state)
+{
+    ar.field(state.action);
+    ar.field(state.result_tag);
+    ar.field(state.result);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(TerrainType) == 600), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, TerrainType &terrain)
+{
+    ar.field(terrain.idx);
+    ar.field(terrain.name);
+    ar.field(terrain.text);
+    ar.field(terrain.tag);
+    ar.field(terrain.mimic_tag);
+    ar.field(terrain.destroyed_tag);
+    ar.field(terrain.mimic);
+    ar.field(terrain.destroyed);
+    ar.field(terrain.flags);
+    ar.field(terrain.priority);
+    ar.field(terrain.state);
+    ar.field(terrain.subtype);
+    ar.field(terrain.power);
+    ar.field(terrain.d_attr);
+    ar.field(terrain.d_char);
+    ar.field(terrain.x_attr);
+    ar.field(terrain.x_char);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(BaseitemInfo) == 224), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, BaseitemInfo &baseitem)
+{
+    ar.field(baseitem.idx);
+    ar.field(baseitem.name);
+    ar.field(baseitem.text);
+    ar.field(baseitem.flavor_name);
+    ar.field(baseitem.bi_key);
+    ar.field(baseitem.pval);
+    ar.field(baseitem.to_h);
+    ar.field(baseitem.to_d);
+    ar.field(baseitem.to_a);
+    ar.field(baseitem.ac);
+    ar.field(baseitem.dd);
+    ar.field(baseitem.ds);
+    ar.field(baseitem.weight);
+    ar.field(baseitem.cost);
+    ar.field(baseitem.flags);
+    ar.field(baseitem.gen_flags);
+    ar.field(baseitem.level);
+    ar.field(baseitem.alloc_tables);
+    ar.field(baseitem.d_attr);
+    ar.field(baseitem.d_char);
+    ar.field(baseitem.easy_know);
+    ar.field(baseitem.act_idx);
+    ar.field(baseitem.x_attr);
+    ar.field(baseitem.x_char);
+    ar.field(baseitem.flavor);
+    ar.field(baseitem.aware);
+    ar.field(baseitem.tried);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(ArtifactType) == 152), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, ArtifactType &artifact)
+{
+    ar.field(artifact.name);
+    ar.field(artifact.text);
+    ar.field(artifact.bi_key);
+    ar.field(artifact.pval);
+    ar.field(artifact.to_h);
+    ar.field(artifact.to_d);
+    ar.field(artifact.to_a);
+    ar.field(artifact.ac);
+    ar.field(artifact.dd);
+    ar.field(artifact.ds);
+    ar.field(artifact.weight);
+    ar.field(artifact.cost);
+    ar.field(artifact.flags);
+    ar.field(artifact.gen_flags);
+    ar.field(artifact.level);
+    ar.field(artifact.rarity);
+    ar.field(artifact.is_generated);
+    ar.field(artifact.floor_id);
+    ar.field(artifact.act_idx);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(ego_generate_type) == 56), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, ego_generate_type &xtra)
+{
+    ar.field(xtra.mul);
+    ar.field(xtra.dev);
+    ar.field(xtra.tr_flags);
+    ar.field(xtra.trg_flags);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(EgoItemDefinition) == 176), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, EgoItemDefinition &ego)
+{
+    ar.field(ego.idx);
+    ar.field(ego.name);
+    ar.field(ego.text);
+    ar.field(ego.slot);
+    ar.field(ego.rating);
+    ar.field(ego.level);
+    ar.field(ego.rarity);
+    ar.field(ego.base_to_h);
+    ar.field(ego.base_to_d);
+    ar.field(ego.base_to_a);
+    ar.field(ego.max_to_h);
+    ar.field(ego.max_to_d);
+    ar.field(ego.max_to_a);
+    ar.field(ego.max_pval);
+    ar.field(ego.cost);
+    ar.field(ego.flags);
+    ar.field(ego.gen_flags);
+    ar.field(ego.xtra_flags);
+    ar.field(ego.act_idx);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(MonsterRaceInfo) == _(536, 504)), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, MonsterRaceInfo &monrace)
+{
+    ar.field(monrace.idx);
+    ar.field(monrace.name);
+#ifdef JP
+    ar.field(monrace.E_name);
+#endif
+    ar.field(monrace.text);
+    ar.field(monrace.hdice);
+    ar.field(monrace.hside);
+    ar.field(monrace.ac);
+    ar.field(monrace.sleep);
+    ar.field(monrace.aaf);
+    ar.field(monrace.speed);
+    ar.field(monrace.mexp);
+    ar.field(monrace.freq_spell);
+    ar.field(monrace.flags1);
+    ar.field(monrace.flags2);
+    ar.field(monrace.flags3);
+    ar.field(monrace.flags7);
+    ar.field(monrace.flags8);
+    ar.field(monrace.ability_flags);
+    ar.field(monrace.aura_flags);
+    ar.field(monrace.behavior_flags);
+    ar.field(monrace.visual_flags);
+    ar.field(monrace.kind_flags);
+    ar.field(monrace.resistance_flags);
+    ar.field(monrace.drop_flags);
+    ar.field(monrace.wilderness_flags);
+    ar.field(monrace.feature_flags);
+    ar.field(monrace.population_flags);
+    ar.field(monrace.speak_flags);
+    ar.field(monrace.brightness_flags);
+    ar.field(monrace.blows);
+    ar.field(monrace.reinforces);
+    ar.field(monrace.drop_artifacts);
+    ar.field(monrace.arena_ratio);
+    ar.field(monrace.next_r_idx);
+    ar.field(monrace.next_exp);
+    ar.field(monrace.level);
+    ar.field(monrace.rarity);
+    ar.field(monrace.d_attr);
+    ar.field(monrace.d_char);
+    ar.field(monrace.x_attr);
+    ar.field(monrace.x_char);
+    ar.field(monrace.max_num);
+    ar.field(monrace.cur_num);
+    ar.field(monrace.floor_id);
+    ar.field(monrace.r_sights);
+    ar.field(monrace.r_deaths);
+    ar.field(monrace.r_pkills);
+    ar.field(monrace.r_akills);
+    ar.field(monrace.r_tkills);
+    ar.field(monrace.r_wake);
+    ar.field(monrace.r_ignore);
+    ar.field(monrace.r_can_evolve);
+    ar.field(monrace.r_drop_gold);
+    ar.field(monrace.r_drop_item);
+    ar.field(monrace.r_cast_spell);
+    ar.field(monrace.r_blows);
+    ar.field(monrace.r_flags1);
+    ar.field(monrace.r_flags2);
+    ar.field(monrace.r_flags3);
+    ar.field(monrace.r_ability_flags);
+    ar.field(monrace.r_aura_flags);
+    ar.field(monrace.r_behavior_flags);
+    ar.field(monrace.r_kind_flags);
+    ar.field(monrace.r_resistance_flags);
+    ar.field(monrace.r_drop_flags);
+    ar.field(monrace.r_feature_flags);
+    ar.field(monrace.defeat_level);
+    ar.field(monrace.defeat_time);
+    ar.field(monrace.cur_hp_per);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(dungeon_type) == 336), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, dungeon_type &dungeon)
+{
+    ar.field(dungeon.idx);
+    ar.field(dungeon.name);
+    ar.field(dungeon.text);
+    ar.field(dungeon.dy);
+    ar.field(dungeon.dx);
+    ar.field(dungeon.floor);
+    ar.field(dungeon.fill);
+    ar.field(dungeon.outer_wall);
+    ar.field(dungeon.inner_wall);
+    ar.field(dungeon.stream1);
+    ar.field(dungeon.stream2);
+    ar.field(dungeon.mindepth);
+    ar.field(dungeon.maxdepth);
+    ar.field(dungeon.min_plev);
+    ar.field(dungeon.pit);
+    ar.field(dungeon.nest);
+    ar.field(dungeon.mode);
+    ar.field(dungeon.min_m_alloc_level);
+    ar.field(dungeon.max_m_alloc_chance);
+    ar.field(dungeon.flags);
+    ar.field(dungeon.mflags1);
+    ar.field(dungeon.mflags2);
+    ar.field(dungeon.mflags3);
+    ar.field(dungeon.mflags7);
+    ar.field(dungeon.mflags8);
+    ar.field(dungeon.mon_ability_flags);
+    ar.field(dungeon.mon_behavior_flags);
+    ar.field(dungeon.mon_visual_flags);
+    ar.field(dungeon.mon_kind_flags);
+    ar.field(dungeon.mon_resistance_flags);
+    ar.field(dungeon.mon_drop_flags);
+    ar.field(dungeon.mon_wilderness_flags);
+    ar.field(dungeon.mon_feature_flags);
+    ar.field(dungeon.mon_population_flags);
+    ar.field(dungeon.mon_speak_flags);
+    ar.field(dungeon.mon_brightness_flags);
+    ar.field(dungeon.r_chars);
+    ar.field(dungeon.final_object);
+    ar.field(dungeon.final_artifact);
+    ar.field(dungeon.final_guardian);
+    ar.field(dungeon.special_div);
+    ar.field(dungeon.tunnel_percent);
+    ar.field(dungeon.obj_great);
+    ar.field(dungeon.obj_good);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(skill_table) == 192), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, skill_table &skill)
+{
+    ar.field(skill.w_start);
+    ar.field(skill.w_max);
+    ar.field(skill.s_start);
+    ar.field(skill.s_max);
+}
+
+static_assert(!CHECK_INFO_SIZE || (sizeof(vault_type) == 88), "visit_fields() と INFO_CACHE_FORMAT を更新すること");
+template <typename Archive>
+void visit_fields(Archive &ar, vault_type &vault)
+{
+    ar.field(vault.idx);
+    ar.field(vault.name);
+    ar.field(vault.text);
+    ar.field(vault.typ);
+    ar.field(vault.rat);
+    ar.field(vault.hgt);
+    ar.field(vault.wid);
+}
+
+/*!
+ * @brief 値を1つ書き出す
+ * @details メモリ上の表現をそのまま複写できる型は一括で書き出し、
+ * それ以外のコンテナは要素数に続けて各要素を、構造体は visit_fields() の列挙順に各メンバを書き出す.
+ */
+template <typename T>
+void InfoCacheWriter::field(T &value)
+{
+    static_assert(!std::is_pointer_v<T>, "Pointers cannot be cached.");
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        this->write_raw(&value, sizeof(T));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        auto size = static_cast<uint32_t>(value.size());
+        this->field(size);
+        this->write_raw(value.data(), value.size());
+    } else if constexpr (is_vector<T>::value || is_map<T>::value) {
+        auto size = static_cast<uint32_t>(value.size());
+        this->field(size);
+        for (auto &element : value) {
+            if constexpr (is_map<T>::value) {
+                auto key = element.first;
+                this->field(key);
+                this->field(element.second);
+            } else {
+                this->field(element);
+            }
+        }
+    } else if constexpr (is_std_array<T>::value || std::is_array_v<T>) {
+        for (auto &element : value) {
+            this->field(element);
+        }
+    } else if constexpr (is_tuple<T>::value) {
+        std::apply([this](auto &...elements) { (this->field(elements), ...); }, value);
+    } else {
+        visit_fields(*this, value);
+    }
+}
+
+/*!
+ * @brief 値を1つ読み込む
+ * @details InfoCacheWriter::field() と同じ順序で読み込む.
+ */
+template <typename T>
+void InfoCacheReader::field(T &value)
+{
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        this->read_raw(&value, sizeof(T));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        uint32_t size = 0;
+        this->field(size);
+        if (this->failed || (this->bytes.size() - this->pos < size)) {
+            this->failed = true;
+            return;
+        }
+
+        value.assign(reinterpret_cast<const char *>(this->bytes.data() + this->pos), size);
+        this->pos += size;
+    } else if constexpr (is_vector<T>::value) {
+        uint32_t size = 0;
+        this->field(size);
+        if (this->failed || (this->bytes.size() - this->pos < size)) {
+            this->failed = true;
+            return;
+        }
+
+        value.clear();
+        value.resize(size);
+        for (auto &element : value) {
+            this->field(element);
+        }
+    } else if constexpr (is_map<T>::value) {
+        uint32_t size = 0;
+        this->field(size);
+        value.clear();
+        for (uint32_t i = 0; (i < size) && !this->failed; i++) {
+            typename T::key_type key{};
+            this->field(key);
+            this->field(value.emplace_hint(value.end(), key, typename T::mapped_type{})->second);
+        }
+    } else if constexpr (is_std_array<T>::value || std::is_array_v<T>) {
+        for (auto &element : value) {
+            this->field(element);
+        }
+    } else if constexpr (is_tuple<T>::value) {
+        std::apply([this](auto &...elements) { (this->field(elements), ...); }, value);
+    } else {
+        visit_fields(*this, value);
+    }
+}
+
+/*!
+ * @brief キャッシュする構造体の大きさ一覧
+ * @details 鍵に含めることで、INFO_CACHE_FORMAT の更新を忘れても構造体が変われば古いキャッシュを使わない
+ */
+constexpr std::array INFO_SIZES{
+    sizeof(TerrainState),
+    sizeof(TerrainType),
+    sizeof(BaseitemInfo),
+    sizeof(ArtifactType),
+    sizeof(ego_generate_type),
+    sizeof(EgoItemDefinition),
+    sizeof(MonsterRaceInfo),
+    sizeof(dungeon_type),
+    sizeof(skill_table),
+    sizeof(vault_type),
+};
+
+/*!
+ * @brief キャッシュファイルを置くディレクトリを得る
+ * @return キャッシュディレクトリのパス
+ */
+std::filesystem::path path_info_cache_dir()
+{
+    return path_build(ANGBAND_DIR_USER, "cache");
+}
+
+/*!
+ * @brief キャッシュファイルのパスを得る
+ * @param filename 元テキストのファイル名
+ * @return キャッシュファイルのパス
+ */
+std::filesystem::path path_info_cache(std::string_view filename)
+{
+    auto name = std::filesystem::path(filename).stem().string();
+    name.append(_("_j.raw", ".raw"));
+    return path_build(path_info_cache_dir(), name);
+}
+
+/*!
+ * @brief 実行中のゲーム本体のパスを得る
+ * @return 実行ファイルのパス. 分からなければ空のパス
+ */
+std::filesystem::path get_executable_path()
+{
+#ifdef WINDOWS
+    std::array<wchar_t, 32768> buf{};
+    const auto length = GetModuleFileNameW(nullptr, buf.data(), static_cast<DWORD>(buf.size()));
+    if ((length > 0) && (length < buf.size())) {
+        return std::filesystem::path(buf.data());
+    }
+#else
+    std::error_code ec;
+    const auto &path = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (!ec) {
+        return path;
+    }
+#endif
+
+    if ((argv0 != nullptr) && (std::string_view(argv0).find_first_of("/\\") != std::string_view::npos)) {
+        return std::filesystem::path(argv0);
+    }
+
+    return {};
+}
+
+/*!
+ * @brief ゲーム本体のビルドを識別する値を計算する
+ * @return ビルドの識別値
+ * @details 解析処理や列挙値の変更は構造体の大きさに表れないことがあるため、ビルド毎に鍵を変える.
+ * このファイルのコンパイル日時に加え、再リンクの度に変わる実行ファイルの大きさと更新日時を用いる.
+ * 実行ファイルが見つからない環境ではコンパイル日時のみで識別する.
+ */
+uint64_t calc_build_identity()
+{
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    auto identity = 0xcbf29ce484222325ULL;
+    const auto hash = [&identity](std::string_view str) {
+        for (const auto c : str) {
+            identity = (identity ^ static_cast<byte>(c)) * prime;
+        }
+    };
+
+    hash(__DATE__ " " __TIME__);
+    const auto &path = get_executable_path();
+    if (path.empty()) {
+        return identity;
+    }
+
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (!ec) {
+        hash(std::to_string(size));
+    }
+
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (!ec) {
+        hash(std::to_string(time.time_since_epoch().count()));
+    }
+
+    return identity;
+}
+
+/*!
+ * @brief 元テキストとゲームのビルドからキャッシュの鍵を計算する (FNV-1a)
+ * @param filename 元テキストのファイル名
+ * @param info_size キャッシュする構造体の大きさ
+ * @param dependencies 解析時に参照する他の元テキストのファイル名
+ * @return キャッシュの鍵. 元テキストを読めなければ std::nullopt
+ * @details 参照先のテキストが変わると解析結果 (地形タグから変換したIDなど) も変わるため、参照先の内容も鍵に含める
+ */
+std::optional<uint64_t> calc_info_cache_key(std::string_view filename, size_t info_size, std::initializer_list<std::string_view> dependencies)
+{
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    auto key = 0xcbf29ce484222325ULL;
+    const auto hash = [&key](uint64_t value) {
+        for (auto i = 0; i < 8; i++) {
+            key = (key ^ ((value >> (i * 8)) & 0xFF)) * prime;
+        }
+    };
+    const auto hash_file = [&key](std::string_view name) {
+        std::ifstream ifs(path_parse(path_build(ANGBAND_DIR_EDIT, name)), std::ios::binary);
+        if (!ifs) {
+            return false;
+        }
+
+        char buf[65536];
+        while (ifs.read(buf, sizeof(buf)) || (ifs.gcount() > 0)) {
+            const auto size = ifs.gcount();
+            for (std::streamsize i = 0; i < size; i++) {
+                key = (key ^ static_cast<byte>(buf[i])) * prime;
+            }
+        }
+
+        return true;
+    };
+
+    static const auto build_identity = calc_build_identity();
+    hash(INFO_CACHE_FORMAT);
+    hash((H_VER_MAJOR << 24) | (H_VER_MINOR << 16) | (H_VER_PATCH << 8) | H_VER_EXTRA);
+    hash(build_identity);
+    hash(info_size);
+    for (const auto size : INFO_SIZES) {
+        hash(size);
+    }
+
+    if (!hash_file(filename)) {
+        return std::nullopt;
+    }
+
+    for (const auto dependency : dependencies) {
+        if (!hash_file(dependency)) {
+            return std::nullopt;
+        }
+    }
+
+    return key;
+}
+
+}
+
+/*!
+ * @brief ゲームデータをキャッシュから読み込む
+ * @param filename 元テキストのファイル名
+ * @param head 読み込んだヘッダの格納先
+ * @param info 読み込んだデータの格納先
+ * @param dependencies 解析時に参照する他の元テキストのファイル名
+ * @return 読み込めたか. 鍵が一致しない、あるいはキャッシュが壊れていれば false を返し、head と info を変更しない
+ */
+template <typename InfoType>
+bool load_info_cache(std::string_view filename, angband_header &head, InfoType &info, std::initializer_list<std::string_view> dependencies)
+{
+    const auto key = calc_info_cache_key(filename, sizeof(typename InfoType::value_type), dependencies);
+    if (!key) {
+        return false;
+    }
+
+    std::ifstream ifs(path_parse(path_info_cache(filename)), std::ios::binary);
+    if (!ifs) {
+        return false;
+    }
+
+    const std::vector<byte> bytes{ std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+    InfoCacheReader reader(bytes, 0);
+    uint64_t cached_key = 0;
+    reader.field(cached_key);
+    if (reader.failed || (cached_key != *key)) {
+        return false;
+    }
+
+    auto cached_head = head;
+    reader.field(cached_head.checksum);
+    reader.field(cached_head.info_num);
+    InfoType cached_info{};
+    reader.field(cached_info);
+    if (!reader.is_end()) {
+        return false;
+    }
+
+    head = cached_head;
+    info = std::move(cached_info);
+    return true;
+}
+
+/*!
+ * @brief 解析したゲームデータをキャッシュへ書き出す
+ * @param filename 元テキストのファイル名
+ * @param head 書き出すヘッダ
+ * @param info 書き出すデータ
+ * @param dependencies 解析時に参照する他の元テキストのファイル名
+ * @details 書き出せなかった場合は何もしない (次回起動時も元テキストを解析する)
+ */
+template <typename InfoType>
+void save_info_cache(std::string_view filename, const angband_header &head, InfoType &info, std::initializer_list<std::string_view> dependencies)
+{
+    auto key = calc_info_cache_key(filename, sizeof(typename InfoType::value_type), dependencies);
+    if (!key) {
+        return;
+    }
+
+    InfoCacheWriter writer;
+    writer.field(*key);
+    auto cached_head = head;
+    writer.field(cached_head.checksum);
+    writer.field(cached_head.info_num);
+    writer.field(info);
+
+    std::error_code ec;
+    std::filesystem::create_directories(path_parse(path_info_cache_dir()), ec);
+    const auto &path = path_info_cache(filename);
+    auto *fp = angband_fopen(path, FileOpenMode::WRITE, true);
+    if (!fp) {
+        return;
+    }
+
+    const auto is_written = fwrite(writer.bytes.data(), 1, writer.bytes.size(), fp) == writer.bytes.size();
+    angband_fclose(fp);
+    if (!is_written) {
+        fd_kill(path);
+    }
+}
+
+template bool load_info_cache(std::string_view, angband_header &, std::map<FixedArtifactId, ArtifactType> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<BaseitemInfo> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<player_magic> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<skill_table> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<dungeon_type> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::map<EgoType, EgoItemDefinition> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<TerrainType> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::map<MonsterRaceId, MonsterRaceInfo> &, std::initializer_list<std::string_view>);
+template bool load_info_cache(std::string_view, angband_header &, std::vector<vault_type> &, std::initializer_list<std::string_view>);
+
+template void save_info_cache(std::string_view, const angband_header &, std::map<FixedArtifactId, ArtifactType> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<BaseitemInfo> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<player_magic> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<skill_table> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<dungeon_type> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::map<EgoType, EgoItemDefinition> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<TerrainType> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::map<MonsterRaceId, MonsterRaceInfo> &, std::initializer_list<std::string_view>);
+template void save_info_cache(std::string_view, const angband_header &, std::vector<vault_type> &, std::initializer_list<std::string_view>);
@@ -0,0 +1,16 @@
+﻿#pragma once
+/*!
+ * @file info-cache.h
+ * @brief ゲームデータのバイナリキャッシュ処理ヘッダ
+ */
+
+#include <initializer_list>
+#include <string_view>
+
+struct angband_header;
+
+template <typename InfoType>
+bool load_info_cache(std::string_view filename, angband_header &head, InfoType &info, std::initializer_list<std::string_view> dependencies = {});
+
+template <typename InfoType>
+void save_info_cache(std::string_view filename, const angband_header &head, InfoType &info, std::initializer_list<std::string_view> dependencies = {});
@@ -20,6 +20,7 @@
 #include "io/files-util.h"
 #include "io/uid-checker.h"
 #include "main/angband-headers.h"
+#include "main/info-cache.h"
 #include "main/init-error-messages-table.h"
 #include "monster-race/monster-race.h"
 #include "object-enchant/object-ego.h"
@@ -38,6 +39,7 @@
 #include "view/display-messages.h"
 #include "world/world.h"
 #include <fstream>
+#include <initializer_list>
 #include <string>
 #include <string_view>
 #include <sys/stat.h>
@@ -88,14 +90,24 @@ static void init_header(angband_header *head, IDX num = 0)
  * @param filename ファイル名(拡張子txt)
  * @param head 処理に用いるヘッダ構造体
  * @param info データ保管先の構造体ポインタ
+ * @param parser 解析関数
+ * @param retouch 解析後の補正関数
+ * @param dependencies 解析時に参照する他のテキストのファイル名 (キャッシュの鍵に含める)
  * @return エラーコード
+ * @details
+ * 前回の解析結果が lib/data/ にキャッシュされており、元テキストが変更されていなければそれを読み込む.
+ * 解析した場合は結果をキャッシュへ書き出す.
  * @note
  * Note that we let each entry have a unique "name" and "text" string,
  * even if the string happens to be empty (everyone has a unique '\0').
  */
 template <typename InfoType>
-static errr init_info(std::string_view filename, angband_header &head, InfoType &info, Parser parser, Retoucher retouch = nullptr)
+static errr init_info(std::string_view filename, angband_header &head, InfoType &info, Parser parser, Retoucher retouch = nullptr, std::initializer_list<std::string_view> dependencies = {})
 {
+    if (load_info_cache(filename, head, info, dependencies)) {
+        return 0;
+    }
+
     const auto &path = path_build(ANGBAND_DIR_EDIT, filename);
     auto *fp = angband_fopen(path, FileOpenMode::READ);
     if (!fp) {
@@ -133,6 +145,7 @@ static errr init_info(std::string_view filename, angband_header &head, InfoType
         (*retouch)(&head);
     }
 
+    save_info_cache(filename, head, info, dependencies);
     return 0;
 }
 
@@ -183,7 +196,7 @@ errr init_class_skills_info()
 errr init_dungeons_info()
 {
     init_header(&dungeons_header);
-    return init_info("DungeonDefinitions.txt", dungeons_header, dungeons_info, parse_dungeons_info);
+    return init_info("DungeonDefinitions.txt", dungeons_header, dungeons_info, parse_dungeons_info, nullptr, { "TerrainDefinitions.txt" });
 }
 
 /*!
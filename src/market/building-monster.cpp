@@ -146,7 +146,7 @@ bool research_mon(PlayerType *player_ptr)
     char query = 'y';
 
     if (why) {
-        ang_sort(player_ptr, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+        sort_monrace_ids(who, why);
     }
 
     uint i;
@@ -98,6 +98,7 @@ void delete_monster_idx(PlayerType *player_ptr, MONSTER_IDX i)
 
     *m_ptr = {};
     floor_ptr->m_cnt--;
+    floor_ptr->live_monster_indices.reset(i);
     lite_spot(player_ptr, y, x);
     if (r_ptr->brightness_flags.has_any_of(ld_mask)) {
         RedrawingFlagsUpdater::get_instance().set_flag(StatusRecalculatingFlag::MONSTER_LITE);
@@ -155,6 +156,7 @@ void wipe_monsters_list(PlayerType *player_ptr)
 
     floor_ptr->m_max = 1;
     floor_ptr->m_cnt = 0;
+    floor_ptr->live_monster_indices.clear();
     for (int i = 0; i < MAX_MTIMED; i++) {
         floor_ptr->mproc_max[i] = 0;
     }
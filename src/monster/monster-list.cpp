@@ -47,6 +47,9 @@
 #include "world/world.h"
 #include <cmath>
 #include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
 
 #define HORDE_NOGOOD 0x01 /*!< (未実装フラグ)HORDE生成でGOODなモンスターの生成を禁止する？ */
 #define HORDE_NOEVIL 0x02 /*!< (未実装フラグ)HORDE生成でEVILなモンスターの生成を禁止する？ */
@@ -56,6 +59,8 @@
  * @return 利用可能なモンスター配列の添字
  * @details
  * This routine should almost never fail, but it *can* happen.
+ * 再利用する空きは生存モンスターの添字集合から探すため、配列全体を走査せずに済む.
+ * 添字の小さい空きから順に使う点は従来通りで、セーブデータ上の並びも変わらない.
  */
 MONSTER_IDX m_pop(FloorType *floor_ptr)
 {
@@ -64,16 +69,18 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
         MONSTER_IDX i = floor_ptr->m_max;
         floor_ptr->m_max++;
         floor_ptr->m_cnt++;
+        floor_ptr->live_monster_indices.set(i);
         return i;
     }
 
     /* Recycle dead monsters */
-    for (MONSTER_IDX i = 1; i < floor_ptr->m_max; i++) {
-        MonsterEntity *m_ptr;
-        m_ptr = &floor_ptr->m_list[i];
-        if (MonsterRace(m_ptr->r_idx).is_valid()) {
+    auto &live_indices = floor_ptr->live_monster_indices;
+    for (auto i = live_indices.find_next_unset(1); i < floor_ptr->m_max; i = live_indices.find_next_unset(i + 1)) {
+        live_indices.set(i);
+        if (MonsterRace(floor_ptr->m_list[i].r_idx).is_valid()) {
             continue;
         }
+
         floor_ptr->m_cnt++;
         return i;
     }
@@ -84,6 +91,134 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
     return 0;
 }
 
+/*!
+ * @brief 生成テーブルの要素が現在生成可能かを判定する
+ * @param r_idx モンスター種族ID
+ * @param option 生成オプション
+ * @return 生成可能ならtrue
+ * @details ユニークの生存数のように、生成テーブルの重みとは無関係に変化する条件のみを判定する.
+ */
+static bool is_mon_num_available(MonsterRaceId r_idx, BIT_FLAGS option)
+{
+    if ((option & GMN_ARENA) || chameleon_change_m_idx) {
+        return true;
+    }
+
+    const auto &monrace = monraces_info[r_idx];
+    if ((monrace.kind_flags.has(MonsterKindType::UNIQUE) || monrace.population_flags.has(MonsterPopulationType::NAZGUL)) && (monrace.cur_num >= monrace.max_num)) {
+        return false;
+    }
+
+    if ((monrace.flags7 & (RF7_UNIQUE2)) && (monrace.cur_num >= 1)) {
+        return false;
+    }
+
+    if (r_idx == MonsterRaceId::BANORLUPART) {
+        if (monraces_info[MonsterRaceId::BANOR].cur_num > 0) {
+            return false;
+        }
+        if (monraces_info[MonsterRaceId::LUPART].cur_num > 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 指定した階層範囲の生成テーブルを確率テーブルとして取得する
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @return 生成テーブルの添字を項目とする確率テーブル
+ * @details 生成可能かどうかの判定 (is_mon_num_available) は含まない.
+ * 構築した確率テーブルは生成テーブルの重みが変わるまで階層範囲ごとに保持し、使い回す.
+ */
+static const ProbabilityTable<int> &get_mon_num_table(DEPTH min_level, DEPTH max_level)
+{
+    static uint32_t cached_generation = 0;
+    static std::map<std::pair<DEPTH, DEPTH>, ProbabilityTable<int>> cached_tables;
+    if (cached_generation != mon_num_prep_generation) {
+        cached_tables.clear();
+        cached_generation = mon_num_prep_generation;
+    }
+
+    const auto &[it, is_new] = cached_tables.try_emplace({ min_level, max_level });
+    auto &prob_table = it->second;
+    if (!is_new) {
+        return prob_table;
+    }
+
+    for (auto i = 0U; i < alloc_race_table.size(); i++) {
+        const auto &entry = alloc_race_table[i];
+        if (entry.level < min_level) {
+            continue;
+        }
+        if (max_level < entry.level) {
+            break;
+        } // sorted by depth array,
+
+        prob_table.entry_item(i, entry.prob2);
+    }
+
+    prob_table.build_alias_table();
+    return prob_table;
+}
+
+/*!
+ * @brief 指定した階層範囲で現在生成可能なモンスターのみから成る確率テーブルを作る
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @param option 生成オプション
+ * @return 生成テーブルの添字を項目とする確率テーブル
+ */
+static ProbabilityTable<int> make_available_mon_num_table(DEPTH min_level, DEPTH max_level, BIT_FLAGS option)
+{
+    ProbabilityTable<int> prob_table;
+    for (auto i = 0U; i < alloc_race_table.size(); i++) {
+        const auto &entry = alloc_race_table[i];
+        if (entry.level < min_level) {
+            continue;
+        }
+        if (max_level < entry.level) {
+            break;
+        } // sorted by depth array,
+
+        if (is_mon_num_available(i2enum<MonsterRaceId>(entry.index), option)) {
+            prob_table.entry_item(i, entry.prob2);
+        }
+    }
+
+    return prob_table;
+}
+
+/*!
+ * @brief 現在生成可能なモンスターを1体抽選する
+ * @param prob_table get_mon_num_table() で取得した確率テーブル
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @param option 生成オプション
+ * @return 選ばれた生成テーブルの添字. 生成可能なモンスターがいなければ std::nullopt
+ * @details 生成できない種族が選ばれたら引き直す. これは生成可能な種族のみで作った確率テーブルからの抽選と同じ確率分布になる.
+ * 生成できない種族ばかり選ばれる場合は、生成可能な種族のみで確率テーブルを作り直して抽選する.
+ */
+static std::optional<int> pick_available_mon_num(const ProbabilityTable<int> &prob_table, DEPTH min_level, DEPTH max_level, BIT_FLAGS option)
+{
+    constexpr auto max_retries = 16;
+    for (auto i = 0; i < max_retries; i++) {
+        const auto idx = prob_table.pick_one_at_random();
+        if (is_mon_num_available(i2enum<MonsterRaceId>(alloc_race_table[idx].index), option)) {
+            return idx;
+        }
+    }
+
+    const auto available_table = make_available_mon_num_table(min_level, max_level, option);
+    if (available_table.empty()) {
+        return std::nullopt;
+    }
+
+    return available_table.pick_one_at_random();
+}
+
 /*!
  * @brief 生成モンスター種族を1種生成テーブルから選択する
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -142,46 +277,13 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
         }
     }
 
-    ProbabilityTable<int> prob_table;
-
-    /* Process probabilities */
-    for (auto i = 0U; i < alloc_race_table.size(); i++) {
-        const auto &entry = alloc_race_table[i];
-        if (entry.level < min_level) {
-            continue;
-        }
-        if (max_level < entry.level) {
-            break;
-        } // sorted by depth array,
-        auto r_idx = i2enum<MonsterRaceId>(entry.index);
-        auto r_ptr = &monraces_info[r_idx];
-        if (!(option & GMN_ARENA) && !chameleon_change_m_idx) {
-            if ((r_ptr->kind_flags.has(MonsterKindType::UNIQUE) || r_ptr->population_flags.has(MonsterPopulationType::NAZGUL)) && (r_ptr->cur_num >= r_ptr->max_num)) {
-                continue;
-            }
-
-            if ((r_ptr->flags7 & (RF7_UNIQUE2)) && (r_ptr->cur_num >= 1)) {
-                continue;
-            }
-
-            if (r_idx == MonsterRaceId::BANORLUPART) {
-                if (monraces_info[MonsterRaceId::BANOR].cur_num > 0) {
-                    continue;
-                }
-                if (monraces_info[MonsterRaceId::LUPART].cur_num > 0) {
-                    continue;
-                }
-            }
-        }
-
-        prob_table.entry_item(i, entry.prob2);
-    }
-
     if (cheat_hear) {
-        msg_format(_("モンスター第3次候補数:%lu(%d-%dF)%d ", "monster third selection:%lu(%d-%dF)%d "), prob_table.item_count(), min_level, max_level,
-            prob_table.total_prob());
+        const auto available_table = make_available_mon_num_table(min_level, max_level, option);
+        msg_format(_("モンスター第3次候補数:%lu(%d-%dF)%d ", "monster third selection:%lu(%d-%dF)%d "), available_table.item_count(), min_level, max_level,
+            available_table.total_prob() / MON_NUM_PROB_SCALE);
     }
 
+    const auto &prob_table = get_mon_num_table(min_level, max_level);
     if (prob_table.empty()) {
         return MonsterRace::empty_id();
     }
@@ -198,7 +300,14 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
     }
 
     std::vector<int> result;
-    ProbabilityTable<int>::lottery(std::back_inserter(result), prob_table, n);
+    for (auto i = 0; i < n; i++) {
+        const auto idx = pick_available_mon_num(prob_table, min_level, max_level, option);
+        if (!idx) {
+            return MonsterRace::empty_id();
+        }
+
+        result.push_back(*idx);
+    }
 
     auto it = std::max_element(result.begin(), result.end(), [](int a, int b) { return alloc_race_table[a].level < alloc_race_table[b].level; });
 
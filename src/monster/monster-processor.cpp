@@ -152,7 +152,7 @@ void process_monster(PlayerType *player_ptr, MONSTER_IDX m_idx)
     }
 
     if (turn_flags_ptr->is_riding_mon) {
-        RedrawingFlagsUpdater::get_instance().set_flag(StatusRecalculatingFlag::BONUS);
+        RedrawingFlagsUpdater::get_instance().set_flag(StatusRecalculatingFlag::BONUS_RIDING);
     }
 
     process_angar(player_ptr, m_idx, turn_flags_ptr->see_m);
@@ -586,19 +586,24 @@ void process_monsters(PlayerType *player_ptr)
 /*!
  * @brief フロア内のモンスターについてターン終了時の処理を繰り返す
  * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 生存しているモンスターの添字集合を辿り、空きスロットは64個単位で読み飛ばす.
+ * 走査中に生まれたモンスターも集合に加わるため、添字の降順に処理する従来の順序は変わらない.
  */
 void sweep_monster_process(PlayerType *player_ptr)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    for (MONSTER_IDX i = floor_ptr->m_max - 1; i >= 1; i--) {
-        MonsterEntity *m_ptr;
-        m_ptr = &floor_ptr->m_list[i];
+    if (player_ptr->wild_mode) {
+        return;
+    }
 
+    const auto &live_monster_indices = floor_ptr->live_monster_indices;
+    for (auto i = live_monster_indices.find_prev(floor_ptr->m_max - 1); i >= 1; i = live_monster_indices.find_prev(i - 1)) {
+        auto *m_ptr = &floor_ptr->m_list[i];
         if (player_ptr->leaving) {
             return;
         }
 
-        if (!m_ptr->is_valid() || player_ptr->wild_mode) {
+        if (!m_ptr->is_valid()) {
             continue;
         }
 
@@ -47,6 +47,13 @@ int chameleon_change_m_idx = 0;
  */
 summon_type summon_specific_type = SUMMON_NONE;
 
+/*!
+ * @var mon_num_prep_generation
+ * @brief モンスター生成テーブルの重み (prob2) が変更された回数
+ * @details get_mon_num() が構築済みの確率テーブルを使い回してよいか判定するために用いる
+ */
+uint32_t mon_num_prep_generation = 0;
+
 /**
  * @brief モンスターがダンジョンに出現できる条件を満たしているかのフラグ判定関数(AND)
  *
@@ -228,6 +235,78 @@ monsterrace_hook_type get_monster_hook2(PlayerType *player_ptr, POSITION y, POSI
     return (monsterrace_hook_type)mon_hook_floor;
 }
 
+/*!
+ * @brief モンスター生成テーブルの要素1つの重みを指定条件に従って計算する。
+ * @param player_ptr
+ * @param entry モンスター生成テーブルの要素
+ * @param hook1 生成制約関数1 (nullptr の場合、制約なし)
+ * @param hook2 生成制約関数2 (nullptr の場合、制約なし)
+ * @param restrict_to_dungeon 現在プレイヤーのいるダンジョンの制約を適用するか
+ * @return 修正後の重み (生成禁止なら 0)
+ */
+static PROB calc_mon_num_prob2(PlayerType *player_ptr, const alloc_entry &entry, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
+{
+    const FloorType *const floor_ptr = player_ptr->current_floor_ptr;
+    const auto entry_r_idx = i2enum<MonsterRaceId>(entry.index);
+    const MonsterRaceInfo *const r_ptr = &monraces_info[entry_r_idx];
+
+    // 基本重みが 0 以下なら生成禁止。
+    // テーブル内の無効エントリもこれに該当する(alloc_race_table は生成時にゼロクリアされるため)。
+    if (entry.prob1 <= 0) {
+        return 0;
+    }
+
+    // いずれかの生成制約関数が偽を返したら生成禁止。
+    if ((hook1 && !hook1(player_ptr, entry_r_idx)) || (hook2 && !hook2(player_ptr, entry_r_idx))) {
+        return 0;
+    }
+
+    // 原則生成禁止するものたち(フェイズアウト状態 / カメレオンの変身先 / ダンジョンの主召喚 は例外)。
+    if (!player_ptr->phase_out && !chameleon_change_m_idx && summon_specific_type != SUMMON_GUARDIANS) {
+        // クエストモンスターは生成禁止。
+        if (r_ptr->flags1 & RF1_QUESTOR) {
+            return 0;
+        }
+
+        // ダンジョンの主は生成禁止。
+        if (r_ptr->flags7 & RF7_GUARDIAN) {
+            return 0;
+        }
+
+        // RF1_FORCE_DEPTH フラグ持ちは指定階未満では生成禁止。
+        if ((r_ptr->flags1 & RF1_FORCE_DEPTH) && (r_ptr->level > floor_ptr->dun_level)) {
+            return 0;
+        }
+
+        // クエスト内でRES_ALLの生成を禁止する (殲滅系クエストの詰み防止)
+        if (inside_quest(player_ptr->current_floor_ptr->quest_number) && r_ptr->resistance_flags.has(MonsterResistanceType::RESIST_ALL)) {
+            return 0;
+        }
+    }
+
+    // 生成を許可するものは基本重みを MON_NUM_PROB_SCALE 倍して引き継ぐ。
+    auto prob2 = static_cast<PROB>(entry.prob1 * MON_NUM_PROB_SCALE);
+
+    // 引数で指定されていればさらにダンジョンによる制約を試みる。
+    if (restrict_to_dungeon) {
+        // ダンジョンによる制約を適用する条件:
+        //
+        //   * フェイズアウト状態でない
+        //   * 1階かそれより深いところにいる
+        //   * ランダムクエスト中でない
+        const bool in_random_quest = inside_quest(floor_ptr->quest_number) && !QuestType::is_fixed(floor_ptr->quest_number);
+        const bool cond = !player_ptr->phase_out && floor_ptr->dun_level > 0 && !in_random_quest;
+
+        if (cond && !restrict_monster_to_dungeon(floor_ptr, entry_r_idx)) {
+            // ダンジョンによる制約に掛かった場合、重みを special_div/64 倍する。
+            // 重みは64倍で持っているため端数は出ない。準備の度に重みが変わらないよう乱数で丸めることはしない。
+            prob2 = static_cast<PROB>(entry.prob1 * floor_ptr->get_dungeon_definition().special_div);
+        }
+    }
+
+    return prob2;
+}
+
 /*!
  * @brief モンスター生成テーブルの重みを指定条件に従って変更する。
  * @param player_ptr
@@ -237,12 +316,11 @@ monsterrace_hook_type get_monster_hook2(PlayerType *player_ptr, POSITION y, POSI
  * @return 常に 0
  *
  * モンスター生成テーブル alloc_race_table の各要素の基本重み prob1 を指定条件
- * に従って変更し、結果を prob2 に書き込む。
+ * に従って変更し、MON_NUM_PROB_SCALE 倍した結果を prob2 に書き込む。
+ * いずれかの重みが前回から変わった場合は mon_num_prep_generation を進める。
  */
 static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
 {
-    const FloorType *const floor_ptr = player_ptr->current_floor_ptr;
-
     // デバッグ用統計情報。
     int mon_num = 0; // 重み(prob2)が正の要素数
     DEPTH lev_min = MAX_DEPTH; // 重みが正の要素のうち最小階
@@ -250,87 +328,32 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
     int prob2_total = 0; // 重みの総和
 
     // モンスター生成テーブルの各要素について重みを修正する。
-    for (auto i = 0U; i < alloc_race_table.size(); i++) {
-        alloc_entry *const entry = &alloc_race_table[i];
-        const auto entry_r_idx = i2enum<MonsterRaceId>(entry->index);
-        const MonsterRaceInfo *const r_ptr = &monraces_info[entry_r_idx];
-
-        // 生成を禁止する要素は重み 0 とする。
-        entry->prob2 = 0;
-
-        // 基本重みが 0 以下なら生成禁止。
-        // テーブル内の無効エントリもこれに該当する(alloc_race_table は生成時にゼロクリアされるため)。
-        if (entry->prob1 <= 0) {
-            continue;
-        }
-
-        // いずれかの生成制約関数が偽を返したら生成禁止。
-        if ((hook1 && !hook1(player_ptr, entry_r_idx)) || (hook2 && !hook2(player_ptr, entry_r_idx))) {
-            continue;
-        }
-
-        // 原則生成禁止するものたち(フェイズアウト状態 / カメレオンの変身先 / ダンジョンの主召喚 は例外)。
-        if (!player_ptr->phase_out && !chameleon_change_m_idx && summon_specific_type != SUMMON_GUARDIANS) {
-            // クエストモンスターは生成禁止。
-            if (r_ptr->flags1 & RF1_QUESTOR) {
-                continue;
-            }
-
-            // ダンジョンの主は生成禁止。
-            if (r_ptr->flags7 & RF7_GUARDIAN) {
-                continue;
-            }
-
-            // RF1_FORCE_DEPTH フラグ持ちは指定階未満では生成禁止。
-            if ((r_ptr->flags1 & RF1_FORCE_DEPTH) && (r_ptr->level > floor_ptr->dun_level)) {
-                continue;
-            }
-
-            // クエスト内でRES_ALLの生成を禁止する (殲滅系クエストの詰み防止)
-            if (inside_quest(player_ptr->current_floor_ptr->quest_number) && r_ptr->resistance_flags.has(MonsterResistanceType::RESIST_ALL)) {
-                continue;
-            }
-        }
-
-        // 生成を許可するものは基本重みをそのまま引き継ぐ。
-        entry->prob2 = entry->prob1;
-
-        // 引数で指定されていればさらにダンジョンによる制約を試みる。
-        if (restrict_to_dungeon) {
-            // ダンジョンによる制約を適用する条件:
-            //
-            //   * フェイズアウト状態でない
-            //   * 1階かそれより深いところにいる
-            //   * ランダムクエスト中でない
-            const bool in_random_quest = inside_quest(floor_ptr->quest_number) && !QuestType::is_fixed(floor_ptr->quest_number);
-            const bool cond = !player_ptr->phase_out && floor_ptr->dun_level > 0 && !in_random_quest;
-
-            if (cond && !restrict_monster_to_dungeon(floor_ptr, entry_r_idx)) {
-                // ダンジョンによる制約に掛かった場合、重みを special_div/64 倍する。
-                // 丸めは確率的に行う。
-                const int numer = entry->prob2 * floor_ptr->get_dungeon_definition().special_div;
-                const int q = numer / 64;
-                const int r = numer % 64;
-                entry->prob2 = (PROB)(randint0(64) < r ? q + 1 : q);
-            }
-        }
+    auto is_changed = false;
+    for (auto &entry : alloc_race_table) {
+        const auto prob2 = calc_mon_num_prob2(player_ptr, entry, hook1, hook2, restrict_to_dungeon);
+        is_changed |= entry.prob2 != prob2;
+        entry.prob2 = prob2;
 
         // 統計情報更新。
-        if (entry->prob2 > 0) {
+        if (entry.prob2 > 0) {
             mon_num++;
-            if (lev_min > entry->level) {
-                lev_min = entry->level;
+            if (lev_min > entry.level) {
+                lev_min = entry.level;
             }
-            if (lev_max < entry->level) {
-                lev_max = entry->level;
+            if (lev_max < entry.level) {
+                lev_max = entry.level;
             }
-            prob2_total += entry->prob2;
+            prob2_total += entry.prob2;
         }
     }
 
+    if (is_changed) {
+        mon_num_prep_generation++;
+    }
+
     // チートオプションが有効なら統計情報を出力。
     if (cheat_hear) {
-        msg_format(_("モンスター第2次候補数:%d(%d-%dF)%d ", "monster second selection:%d(%d-%dF)%d "), mon_num, lev_min, lev_max, prob2_total);
+        msg_format(_("モンスター第2次候補数:%d(%d-%dF)%d ", "monster second selection:%d(%d-%dF)%d "), mon_num, lev_min, lev_max, prob2_total / MON_NUM_PROB_SCALE);
     }
 
     return 0;
@@ -11,6 +11,13 @@ extern MONSTER_IDX hack_m_idx_ii;
 extern int chameleon_change_m_idx;
 enum summon_type : int;
 extern summon_type summon_specific_type;
+extern uint32_t mon_num_prep_generation;
+
+/*!
+ * @brief モンスター生成テーブルの重み (prob2) の倍率
+ * @details ダンジョンによる制約の重み special_div/64 倍を端数なしで表すため、prob2 は基本重みの64倍で持つ
+ */
+constexpr PROB MON_NUM_PROB_SCALE = 64;
 
 monsterrace_hook_type get_monster_hook(PlayerType *player_ptr);
 monsterrace_hook_type get_monster_hook2(PlayerType *player_ptr, POSITION y, POSITION x);
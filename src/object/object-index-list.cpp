@@ -4,36 +4,85 @@
 
 #include <algorithm>
 
+namespace {
+/*!
+ * @brief リスト未確保時に begin()/end() が返すイテレータの参照先となる空リスト
+ * @details ObjectIndexList の公開メソッドを通じて要素が追加されることはない
+ */
+std::list<OBJECT_IDX> empty_o_idx_list;
+}
+
+ObjectIndexList::ObjectIndexList(const ObjectIndexList &other)
+{
+    *this = other;
+}
+
+ObjectIndexList &ObjectIndexList::operator=(const ObjectIndexList &other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    if (other.empty()) {
+        this->clear();
+        return *this;
+    }
+
+    this->allocated_list() = *other.o_idx_list_;
+    return *this;
+}
+
 void ObjectIndexList::add(FloorType *floor_ptr, OBJECT_IDX o_idx, IDX stack_idx)
 {
+    auto &idx_list = this->allocated_list();
     if (stack_idx <= 0) {
-        stack_idx = o_idx_list_.empty() ? 1 : floor_ptr->o_list[o_idx_list_.front()].stack_idx + 1;
+        stack_idx = idx_list.empty() ? 1 : floor_ptr->o_list[idx_list.front()].stack_idx + 1;
     }
 
     auto it = std::partition_point(
-        o_idx_list_.begin(), o_idx_list_.end(), [floor_ptr, stack_idx](IDX idx) { return floor_ptr->o_list[idx].stack_idx > stack_idx; });
+        idx_list.begin(), idx_list.end(), [floor_ptr, stack_idx](IDX idx) { return floor_ptr->o_list[idx].stack_idx > stack_idx; });
 
-    o_idx_list_.insert(it, o_idx);
+    idx_list.insert(it, o_idx);
     floor_ptr->o_list[o_idx].stack_idx = stack_idx;
+    if (floor_ptr->o_list[o_idx].marked.has(OmType::FOUND)) {
+        floor_ptr->found_item_index.add(o_idx);
+    }
 }
 
 void ObjectIndexList::remove(OBJECT_IDX o_idx)
 {
-    o_idx_list_.remove(o_idx);
+    if (this->o_idx_list_) {
+        this->o_idx_list_->remove(o_idx);
+    }
 }
 
 void ObjectIndexList::rotate(FloorType *floor_ptr)
 {
-    if (o_idx_list_.size() < 2) {
+    if (this->size() < 2) {
         return;
     }
 
-    o_idx_list_.push_back(o_idx_list_.front());
-    o_idx_list_.pop_front();
+    auto &idx_list = *this->o_idx_list_;
+    idx_list.push_back(idx_list.front());
+    idx_list.pop_front();
 
-    for (const auto o_idx : o_idx_list_) {
+    for (const auto o_idx : idx_list) {
         floor_ptr->o_list[o_idx].stack_idx++;
     }
 
-    floor_ptr->o_list[o_idx_list_.back()].stack_idx = 1;
+    floor_ptr->o_list[idx_list.back()].stack_idx = 1;
+}
+
+std::list<OBJECT_IDX> &ObjectIndexList::list() const noexcept
+{
+    return this->o_idx_list_ ? *this->o_idx_list_ : empty_o_idx_list;
+}
+
+std::list<OBJECT_IDX> &ObjectIndexList::allocated_list()
+{
+    if (!this->o_idx_list_) {
+        this->o_idx_list_ = std::make_unique<std::list<OBJECT_IDX>>();
+    }
+
+    return *this->o_idx_list_;
 }
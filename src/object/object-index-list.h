@@ -3,6 +3,7 @@
 #include "system/angband.h"
 
 #include <list>
+#include <memory>
 
 class FloorType;
 
@@ -17,6 +18,10 @@ public:
      * @brief デフォルトコンストラクタ
      */
     ObjectIndexList() = default;
+    ObjectIndexList(const ObjectIndexList &other);
+    ObjectIndexList(ObjectIndexList &&other) noexcept = default;
+    ObjectIndexList &operator=(const ObjectIndexList &other);
+    ObjectIndexList &operator=(ObjectIndexList &&other) noexcept = default;
 
     /**
      * @brief アイテムリストにフロア全体のアイテム配列上の指定した要素番号のアイテムを追加する
@@ -56,41 +61,51 @@ public:
     //
     auto empty() const noexcept
     {
-        return o_idx_list_.empty();
+        return !o_idx_list_ || o_idx_list_->empty();
     }
     auto size() const noexcept
     {
-        return o_idx_list_.size();
+        return o_idx_list_ ? o_idx_list_->size() : 0;
     }
     void clear() noexcept
     {
-        o_idx_list_.clear();
+        if (o_idx_list_) {
+            o_idx_list_->clear();
+        }
     }
     auto &front() noexcept
     {
-        return o_idx_list_.front();
+        return o_idx_list_->front();
     }
     void pop_front() noexcept
     {
-        return o_idx_list_.pop_front();
+        return o_idx_list_->pop_front();
     }
     auto begin() noexcept
     {
-        return o_idx_list_.begin();
+        return this->list().begin();
     }
     auto end() noexcept
     {
-        return o_idx_list_.end();
+        return this->list().end();
     }
     auto begin() const noexcept
     {
-        return o_idx_list_.begin();
+        return this->list().begin();
     }
     auto end() const noexcept
     {
-        return o_idx_list_.end();
+        return this->list().end();
     }
 
 private:
-    std::list<OBJECT_IDX> o_idx_list_;
+    /*!
+     * @details 床上のアイテムは大半のマスで空のため、リスト本体は最初の追加時にヒープ上へ確保する.
+     * これにより grid_type 内に占める大きさをポインタ1個分に抑える.
+     * 一度確保したリストはイテレート中の削除に備え、破棄されるまで解放しない.
+     */
+    std::unique_ptr<std::list<OBJECT_IDX>> o_idx_list_;
+
+    std::list<OBJECT_IDX> &list() const noexcept;
+    std::list<OBJECT_IDX> &allocated_list();
 };
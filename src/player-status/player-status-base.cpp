@@ -1,6 +1,6 @@
 ﻿#include "player-status/player-status-base.h"
 #include "inventory/inventory-slot-types.h"
-#include "object/object-flags.h"
+#include "player/equipment-flags-cache.h"
 #include "player/player-status.h"
 #include "system/item-entity.h"
 #include "system/player-type-definition.h"
@@ -210,20 +210,7 @@ void PlayerStatusBase::set_locals()
  */
 BIT_FLAGS PlayerStatusBase::equipments_flags(tr_type check_flag)
 {
-    BIT_FLAGS flags = 0;
-    for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
-        auto *o_ptr = &player_ptr->inventory_list[i];
-        if (!o_ptr->is_valid()) {
-            continue;
-        }
-
-        auto o_flags = object_flags(o_ptr);
-        if (o_flags.has(check_flag)) {
-            set_bits(flags, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
-        }
-    }
-
-    return flags;
+    return EquipmentFlagsCache::get_instance().get_flag_causes(this->player_ptr, check_flag);
 }
 
 /*!
@@ -240,7 +227,7 @@ BIT_FLAGS PlayerStatusBase::equipments_bad_flags(tr_type check_flag)
             continue;
         }
 
-        auto o_flags = object_flags(o_ptr);
+        auto o_flags = EquipmentFlagsCache::get_instance().get_slot_flags(this->player_ptr, i);
         if (o_flags.has(check_flag)) {
             if (o_ptr->pval < 0) {
                 set_bits(flags, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
@@ -261,7 +248,7 @@ int16_t PlayerStatusBase::equipments_bonus()
     int16_t bonus = 0;
     for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
         auto *o_ptr = &player_ptr->inventory_list[i];
-        auto o_flags = object_flags(o_ptr);
+        auto o_flags = EquipmentFlagsCache::get_instance().get_slot_flags(this->player_ptr, i);
         if (!o_ptr->is_valid()) {
             continue;
         }
@@ -0,0 +1,104 @@
+﻿#include "player/equipment-flags-cache.h"
+#include "object/object-flags.h"
+#include "object/tval-types.h"
+#include "player/player-status-flags.h"
+#include "system/item-entity.h"
+#include "system/player-type-definition.h"
+#include "util/bit-flags-calculator.h"
+#include <iterator>
+#include <vector>
+
+EquipmentFlagsCache EquipmentFlagsCache::instance{};
+
+/*!
+ * @brief アイテムから object_flags() の結果を左右する属性を控える
+ * @param item 装備品
+ */
+EquipmentFlagsCache::FlagSource::FlagSource(const ItemEntity &item)
+    : bi_id(item.bi_id)
+    , fixed_artifact_idx(item.fixed_artifact_idx)
+    , ego_idx(item.ego_idx)
+    , art_flags(item.art_flags)
+    , smith_effect(item.smith_effect)
+    , smith_act_idx(item.smith_act_idx)
+    , is_fuel_empty((item.bi_key.tval() == ItemKindType::LITE) && (item.fuel == 0))
+{
+}
+
+EquipmentFlagsCache &EquipmentFlagsCache::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 装備スロットのアイテムの特性フラグを取得する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param slot 装備スロット (INVEN_MAIN_HAND～INVEN_FEET)
+ * @return 特性フラグ. 何も装備していなければ空集合
+ */
+const TrFlags &EquipmentFlagsCache::get_slot_flags(PlayerType *player_ptr, int slot)
+{
+    this->update(player_ptr);
+    return this->slot_flags[slot - INVEN_MAIN_HAND];
+}
+
+/*!
+ * @brief 全装備品の特性フラグの論理和を取得する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 特性フラグ
+ */
+const TrFlags &EquipmentFlagsCache::get_all_flags(PlayerType *player_ptr)
+{
+    this->update(player_ptr);
+    return this->all_flags;
+}
+
+/*!
+ * @brief 特性フラグを与えている装備スロットの集合を取得する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param tr_flag 特性フラグ
+ * @return 装備スロットの flag_cause 集合
+ */
+BIT_FLAGS EquipmentFlagsCache::get_flag_causes(PlayerType *player_ptr, tr_type tr_flag)
+{
+    this->update(player_ptr);
+    return this->flag_causes[tr_flag];
+}
+
+/*!
+ * @brief 控えた属性と食い違う装備スロットの特性フラグを計算し直す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details いずれかのスロットを計算し直した時だけ、論理和とスロットの集合を作り直す
+ */
+void EquipmentFlagsCache::update(PlayerType *player_ptr)
+{
+    auto is_changed = false;
+    for (auto i = 0; i < EQUIPMENT_SLOT_NUM; i++) {
+        const auto &item = player_ptr->inventory_list[INVEN_MAIN_HAND + i];
+        const auto source = item.is_valid() ? FlagSource(item) : FlagSource();
+        if (source == this->sources[i]) {
+            continue;
+        }
+
+        this->sources[i] = source;
+        this->slot_flags[i] = item.is_valid() ? object_flags(&item) : TrFlags();
+        is_changed = true;
+    }
+
+    if (!is_changed) {
+        return;
+    }
+
+    this->all_flags.clear();
+    this->flag_causes.fill(0);
+    std::vector<tr_type> flags;
+    for (auto i = 0; i < EQUIPMENT_SLOT_NUM; i++) {
+        this->all_flags.set(this->slot_flags[i]);
+        const auto flag_cause = convert_inventory_slot_type_to_flag_cause(INVEN_MAIN_HAND + i);
+        flags.clear();
+        TrFlags::get_flags(this->slot_flags[i], std::back_inserter(flags));
+        for (const auto flag : flags) {
+            set_bits(this->flag_causes[flag], flag_cause);
+        }
+    }
+}
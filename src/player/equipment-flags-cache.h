@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include "inventory/inventory-slot-types.h"
+#include "object-enchant/tr-flags.h"
+#include "system/angband.h"
+#include <array>
+#include <optional>
+
+enum class EgoType;
+enum class FixedArtifactId : short;
+enum class RandomArtActType : short;
+enum class SmithEffectType : int16_t;
+class ItemEntity;
+class PlayerType;
+
+/*!
+ * @brief 装備品の特性フラグのキャッシュ
+ * @details
+ * 装備スロット毎の object_flags() の結果と、それらの論理和、
+ * および特性フラグ毎にそれを与えている装備スロットの flag_cause 集合を保持する.
+ * object_flags() の結果を左右するアイテムの属性を装備スロット毎に控えておき、
+ * 参照の度にそれと比べて食い違ったスロットだけを計算し直すので、明示的な破棄は要らない.
+ */
+class EquipmentFlagsCache {
+public:
+    EquipmentFlagsCache(const EquipmentFlagsCache &) = delete;
+    EquipmentFlagsCache(EquipmentFlagsCache &&) = delete;
+    EquipmentFlagsCache &operator=(const EquipmentFlagsCache &) = delete;
+    EquipmentFlagsCache &operator=(EquipmentFlagsCache &&) = delete;
+    ~EquipmentFlagsCache() = default;
+
+    static EquipmentFlagsCache &get_instance();
+
+    const TrFlags &get_slot_flags(PlayerType *player_ptr, int slot);
+    const TrFlags &get_all_flags(PlayerType *player_ptr);
+    BIT_FLAGS get_flag_causes(PlayerType *player_ptr, tr_type tr_flag);
+
+private:
+    EquipmentFlagsCache() = default;
+
+    static EquipmentFlagsCache instance;
+    static constexpr auto EQUIPMENT_SLOT_NUM = INVEN_TOTAL - INVEN_MAIN_HAND;
+
+    /*!
+     * @brief object_flags() の結果を左右するアイテムの属性
+     */
+    struct FlagSource {
+        FlagSource() = default;
+        FlagSource(const ItemEntity &item);
+
+        short bi_id = 0;
+        FixedArtifactId fixed_artifact_idx{};
+        EgoType ego_idx{};
+        TrFlags art_flags{};
+        std::optional<SmithEffectType> smith_effect{};
+        std::optional<RandomArtActType> smith_act_idx{};
+        bool is_fuel_empty = false;
+
+        bool operator==(const FlagSource &) const = default;
+    };
+
+    std::array<FlagSource, EQUIPMENT_SLOT_NUM> sources{};
+    std::array<TrFlags, EQUIPMENT_SLOT_NUM> slot_flags{};
+    TrFlags all_flags{};
+    std::array<BIT_FLAGS, TR_FLAG_MAX> flag_causes{}; //!< 特性フラグ毎の flag_cause 集合
+
+    void update(PlayerType *player_ptr);
+};
@@ -73,6 +73,7 @@
 #include "player-status/player-stealth.h"
 #include "player/attack-defense-types.h"
 #include "player/digestion-processor.h"
+#include "player/equipment-flags-cache.h"
 #include "player/patron.h"
 #include "player/player-damage.h"
 #include "player/player-move.h"
@@ -117,6 +118,7 @@
 #include "util/string-processor.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <map>
 
 static const int extra_magic_glove_reduce_mana = 1;
 
@@ -152,6 +154,34 @@ static int16_t calc_to_hit_misc(PlayerType *player_ptr);
 static DICE_NUMBER calc_to_weapon_dice_num(PlayerType *player_ptr, INVENTORY_IDX slot);
 static player_hand main_attack_hand(PlayerType *player_ptr);
 
+/*!
+ * @brief update_bonuses() で再計算する派生値の区分
+ */
+enum class BonusFieldType {
+    FLAGS, /*!< ESP・透明視・浮遊・呪い等の特性 */
+    ABILITY_SCORES, /*!< 能力値 */
+    WEAPONS, /*!< 武器・射撃の攻撃回数や命中/ダメージ修正 */
+    SPEED, /*!< 加速 */
+    SKILLS, /*!< 隠密・解除・魔道具等の技能と赤外線視力 */
+    ARMOUR, /*!< AC */
+    MAX,
+};
+
+/*!
+ * @brief 能力値修正の要因と、それによって変化し得る派生値の区分
+ * @details
+ * 装備品・一時効果全般・種族/職業/突然変異の変化はほぼ全ての区分に影響するため、BONUS として全て再計算する.
+ * 乗馬の状態は能力値以外の全て、所持品の重量は加速のみ、
+ * 感知系の一時効果 (時限ESP・透明視・赤外線視力・浮遊・再生) は特性と赤外線視力のみに影響する.
+ * 要因を追加する時は、その要因を参照する has_*() と calc_*() を全て調べること.
+ */
+static const std::map<StatusRecalculatingFlag, EnumClassFlagGroup<BonusFieldType>> BONUS_DEPENDENCIES = {
+    { StatusRecalculatingFlag::BONUS, { BonusFieldType::FLAGS, BonusFieldType::ABILITY_SCORES, BonusFieldType::WEAPONS, BonusFieldType::SPEED, BonusFieldType::SKILLS, BonusFieldType::ARMOUR } },
+    { StatusRecalculatingFlag::BONUS_RIDING, { BonusFieldType::FLAGS, BonusFieldType::WEAPONS, BonusFieldType::SPEED, BonusFieldType::SKILLS, BonusFieldType::ARMOUR } },
+    { StatusRecalculatingFlag::BONUS_WEIGHT, { BonusFieldType::SPEED } },
+    { StatusRecalculatingFlag::BONUS_SENSE, { BonusFieldType::FLAGS, BonusFieldType::SKILLS } },
+};
+
 /*** Player information ***/
 
 /*!
@@ -254,9 +284,10 @@ static void update_ability_scores(PlayerType *player_ptr)
  *
  * This function induces various "status" messages.
  * </pre>
+ * @param fields 再計算する派生値の区分
  * @todo ここで計算していた各値は一部の状態変化メッセージ処理を除き、今後必要な時に適示計算する形に移行するためほぼすべて削られる。
  */
-static void update_bonuses(PlayerType *player_ptr)
+static void update_bonuses(PlayerType *player_ptr, const EnumClassFlagGroup<BonusFieldType> &fields)
 {
     auto empty_hands_status = empty_hands(player_ptr, true);
     ItemEntity *o_ptr;
@@ -282,98 +313,119 @@ static void update_bonuses(PlayerType *player_ptr)
     ARMOUR_CLASS old_dis_ac = player_ptr->dis_ac;
     ARMOUR_CLASS old_dis_to_a = player_ptr->dis_to_a;
 
-    player_ptr->xtra_might = has_xtra_might(player_ptr);
-    player_ptr->esp_evil = has_esp_evil(player_ptr);
-    player_ptr->esp_animal = has_esp_animal(player_ptr);
-    player_ptr->esp_undead = has_esp_undead(player_ptr);
-    player_ptr->esp_demon = has_esp_demon(player_ptr);
-    player_ptr->esp_orc = has_esp_orc(player_ptr);
-    player_ptr->esp_troll = has_esp_troll(player_ptr);
-    player_ptr->esp_giant = has_esp_giant(player_ptr);
-    player_ptr->esp_dragon = has_esp_dragon(player_ptr);
-    player_ptr->esp_human = has_esp_human(player_ptr);
-    player_ptr->esp_good = has_esp_good(player_ptr);
-    player_ptr->esp_nonliving = has_esp_nonliving(player_ptr);
-    player_ptr->esp_unique = has_esp_unique(player_ptr);
-    player_ptr->telepathy = has_esp_telepathy(player_ptr);
-    player_ptr->bless_blade = has_bless_blade(player_ptr);
-    player_ptr->easy_2weapon = has_easy2_weapon(player_ptr);
-    player_ptr->down_saving = has_down_saving(player_ptr);
-    player_ptr->yoiyami = has_no_ac(player_ptr);
-    player_ptr->mighty_throw = has_mighty_throw(player_ptr);
-    player_ptr->dec_mana = has_dec_mana(player_ptr);
-    player_ptr->see_nocto = has_see_nocto(player_ptr);
-    player_ptr->warning = has_warning(player_ptr);
-    player_ptr->anti_magic = has_anti_magic(player_ptr);
-    player_ptr->anti_tele = has_anti_tele(player_ptr);
-    player_ptr->easy_spell = has_easy_spell(player_ptr);
-    player_ptr->heavy_spell = has_heavy_spell(player_ptr);
-    player_ptr->hold_exp = has_hold_exp(player_ptr);
-    player_ptr->see_inv = has_see_inv(player_ptr);
-    player_ptr->free_act = has_free_act(player_ptr);
-    player_ptr->levitation = has_levitation(player_ptr);
-    player_ptr->can_swim = has_can_swim(player_ptr);
-    player_ptr->slow_digest = has_slow_digest(player_ptr);
-    player_ptr->regenerate = has_regenerate(player_ptr);
-    update_curses(player_ptr);
-    player_ptr->impact = has_impact(player_ptr);
-    player_ptr->earthquake = has_earthquake(player_ptr);
-    update_extra_blows(player_ptr);
-
-    player_ptr->lite = has_lite(player_ptr);
-
-    if (!PlayerClass(player_ptr).monk_stance_is(MonkStanceType::NONE)) {
+    if (fields.has(BonusFieldType::FLAGS)) {
+        player_ptr->xtra_might = has_xtra_might(player_ptr);
+        player_ptr->esp_evil = has_esp_evil(player_ptr);
+        player_ptr->esp_animal = has_esp_animal(player_ptr);
+        player_ptr->esp_undead = has_esp_undead(player_ptr);
+        player_ptr->esp_demon = has_esp_demon(player_ptr);
+        player_ptr->esp_orc = has_esp_orc(player_ptr);
+        player_ptr->esp_troll = has_esp_troll(player_ptr);
+        player_ptr->esp_giant = has_esp_giant(player_ptr);
+        player_ptr->esp_dragon = has_esp_dragon(player_ptr);
+        player_ptr->esp_human = has_esp_human(player_ptr);
+        player_ptr->esp_good = has_esp_good(player_ptr);
+        player_ptr->esp_nonliving = has_esp_nonliving(player_ptr);
+        player_ptr->esp_unique = has_esp_unique(player_ptr);
+        player_ptr->telepathy = has_esp_telepathy(player_ptr);
+        player_ptr->bless_blade = has_bless_blade(player_ptr);
+        player_ptr->easy_2weapon = has_easy2_weapon(player_ptr);
+        player_ptr->down_saving = has_down_saving(player_ptr);
+        player_ptr->yoiyami = has_no_ac(player_ptr);
+        player_ptr->mighty_throw = has_mighty_throw(player_ptr);
+        player_ptr->dec_mana = has_dec_mana(player_ptr);
+        player_ptr->see_nocto = has_see_nocto(player_ptr);
+        player_ptr->warning = has_warning(player_ptr);
+        player_ptr->anti_magic = has_anti_magic(player_ptr);
+        player_ptr->anti_tele = has_anti_tele(player_ptr);
+        player_ptr->easy_spell = has_easy_spell(player_ptr);
+        player_ptr->heavy_spell = has_heavy_spell(player_ptr);
+        player_ptr->hold_exp = has_hold_exp(player_ptr);
+        player_ptr->see_inv = has_see_inv(player_ptr);
+        player_ptr->free_act = has_free_act(player_ptr);
+        player_ptr->levitation = has_levitation(player_ptr);
+        player_ptr->can_swim = has_can_swim(player_ptr);
+        player_ptr->slow_digest = has_slow_digest(player_ptr);
+        player_ptr->regenerate = has_regenerate(player_ptr);
+        update_curses(player_ptr);
+        player_ptr->impact = has_impact(player_ptr);
+        player_ptr->earthquake = has_earthquake(player_ptr);
+        update_extra_blows(player_ptr);
+
+        player_ptr->lite = has_lite(player_ptr);
+    }
+
+    if (fields.has(BonusFieldType::WEAPONS) && !PlayerClass(player_ptr).monk_stance_is(MonkStanceType::NONE)) {
         if (none_bits(empty_hands_status, EMPTY_HAND_MAIN)) {
             set_action(player_ptr, ACTION_NONE);
         }
     }
 
-    update_ability_scores(player_ptr);
-    o_ptr = &player_ptr->inventory_list[INVEN_BOW];
-    if (o_ptr->is_valid()) {
-        player_ptr->tval_ammo = o_ptr->get_arrow_kind();
-        player_ptr->num_fire = calc_num_fire(player_ptr, o_ptr);
+    if (fields.has(BonusFieldType::ABILITY_SCORES)) {
+        update_ability_scores(player_ptr);
     }
 
-    for (int i = 0; i < 2; i++) {
-        player_ptr->is_icky_wield[i] = is_wielding_icky_weapon(player_ptr, i);
-        player_ptr->is_icky_riding_wield[i] = is_wielding_icky_riding_weapon(player_ptr, i);
-        player_ptr->heavy_wield[i] = is_heavy_wield(player_ptr, i);
-        player_ptr->num_blow[i] = calc_num_blow(player_ptr, i);
-        player_ptr->to_dd[i] = calc_to_weapon_dice_num(player_ptr, INVEN_MAIN_HAND + i);
-        player_ptr->to_ds[i] = 0;
-    }
-
-    player_ptr->pspeed = PlayerSpeed(player_ptr).get_value();
-    player_ptr->see_infra = PlayerInfravision(player_ptr).get_value();
-    player_ptr->skill_stl = PlayerStealth(player_ptr).get_value();
-    player_ptr->skill_dis = calc_disarming(player_ptr);
-    player_ptr->skill_dev = calc_device_ability(player_ptr);
-    player_ptr->skill_sav = calc_saving_throw(player_ptr);
-    player_ptr->skill_srh = calc_search(player_ptr);
-    player_ptr->skill_fos = calc_search_freq(player_ptr);
-    player_ptr->skill_thn = calc_to_hit_melee(player_ptr);
-    player_ptr->skill_thb = calc_to_hit_shoot(player_ptr);
-    player_ptr->skill_tht = calc_to_hit_throw(player_ptr);
-    player_ptr->riding_ryoute = is_riding_two_hands(player_ptr);
-    player_ptr->to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, true);
-    player_ptr->to_d[1] = calc_to_damage(player_ptr, INVEN_SUB_HAND, true);
-    player_ptr->dis_to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, false);
-    player_ptr->dis_to_d[1] = calc_to_damage(player_ptr, INVEN_SUB_HAND, false);
-    player_ptr->to_h[0] = calc_to_hit(player_ptr, INVEN_MAIN_HAND, true);
-    player_ptr->to_h[1] = calc_to_hit(player_ptr, INVEN_SUB_HAND, true);
-    player_ptr->dis_to_h[0] = calc_to_hit(player_ptr, INVEN_MAIN_HAND, false);
-    player_ptr->dis_to_h[1] = calc_to_hit(player_ptr, INVEN_SUB_HAND, false);
-    player_ptr->to_h_b = calc_to_hit_bow(player_ptr, true);
-    player_ptr->dis_to_h_b = calc_to_hit_bow(player_ptr, false);
-    player_ptr->to_d_m = calc_to_damage_misc(player_ptr);
-    player_ptr->to_h_m = calc_to_hit_misc(player_ptr);
-    player_ptr->skill_dig = calc_skill_dig(player_ptr);
-    player_ptr->to_m_chance = calc_to_magic_chance(player_ptr);
-    player_ptr->ac = calc_base_ac(player_ptr);
-    player_ptr->to_a = calc_to_ac(player_ptr, true);
-    player_ptr->dis_ac = calc_base_ac(player_ptr);
-    player_ptr->dis_to_a = calc_to_ac(player_ptr, false);
+    if (fields.has(BonusFieldType::WEAPONS)) {
+        o_ptr = &player_ptr->inventory_list[INVEN_BOW];
+        if (o_ptr->is_valid()) {
+            player_ptr->tval_ammo = o_ptr->get_arrow_kind();
+            player_ptr->num_fire = calc_num_fire(player_ptr, o_ptr);
+        }
+
+        for (int i = 0; i < 2; i++) {
+            player_ptr->is_icky_wield[i] = is_wielding_icky_weapon(player_ptr, i);
+            player_ptr->is_icky_riding_wield[i] = is_wielding_icky_riding_weapon(player_ptr, i);
+            player_ptr->heavy_wield[i] = is_heavy_wield(player_ptr, i);
+            player_ptr->num_blow[i] = calc_num_blow(player_ptr, i);
+            player_ptr->to_dd[i] = calc_to_weapon_dice_num(player_ptr, INVEN_MAIN_HAND + i);
+            player_ptr->to_ds[i] = 0;
+        }
+    }
+
+    if (fields.has(BonusFieldType::SPEED)) {
+        player_ptr->pspeed = PlayerSpeed(player_ptr).get_value();
+    }
+
+    if (fields.has(BonusFieldType::SKILLS)) {
+        player_ptr->see_infra = PlayerInfravision(player_ptr).get_value();
+        player_ptr->skill_stl = PlayerStealth(player_ptr).get_value();
+        player_ptr->skill_dis = calc_disarming(player_ptr);
+        player_ptr->skill_dev = calc_device_ability(player_ptr);
+        player_ptr->skill_sav = calc_saving_throw(player_ptr);
+        player_ptr->skill_srh = calc_search(player_ptr);
+        player_ptr->skill_fos = calc_search_freq(player_ptr);
+        player_ptr->skill_thn = calc_to_hit_melee(player_ptr);
+        player_ptr->skill_thb = calc_to_hit_shoot(player_ptr);
+        player_ptr->skill_tht = calc_to_hit_throw(player_ptr);
+    }
+
+    if (fields.has(BonusFieldType::WEAPONS)) {
+        player_ptr->riding_ryoute = is_riding_two_hands(player_ptr);
+        player_ptr->to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, true);
+        player_ptr->to_d[1] = calc_to_damage(player_ptr, INVEN_SUB_HAND, true);
+        player_ptr->dis_to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, false);
+        player_ptr->dis_to_d[1] = calc_to_damage(player_ptr, INVEN_SUB_HAND, false);
+        player_ptr->to_h[0] = calc_to_hit(player_ptr, INVEN_MAIN_HAND, true);
+        player_ptr->to_h[1] = calc_to_hit(player_ptr, INVEN_SUB_HAND, true);
+        player_ptr->dis_to_h[0] = calc_to_hit(player_ptr, INVEN_MAIN_HAND, false);
+        player_ptr->dis_to_h[1] = calc_to_hit(player_ptr, INVEN_SUB_HAND, false);
+        player_ptr->to_h_b = calc_to_hit_bow(player_ptr, true);
+        player_ptr->dis_to_h_b = calc_to_hit_bow(player_ptr, false);
+        player_ptr->to_d_m = calc_to_damage_misc(player_ptr);
+        player_ptr->to_h_m = calc_to_hit_misc(player_ptr);
+    }
+
+    if (fields.has(BonusFieldType::SKILLS)) {
+        player_ptr->skill_dig = calc_skill_dig(player_ptr);
+        player_ptr->to_m_chance = calc_to_magic_chance(player_ptr);
+    }
+
+    if (fields.has(BonusFieldType::ARMOUR)) {
+        player_ptr->ac = calc_base_ac(player_ptr);
+        player_ptr->to_a = calc_to_ac(player_ptr, true);
+        player_ptr->dis_ac = calc_base_ac(player_ptr);
+        player_ptr->dis_to_a = calc_to_ac(player_ptr, false);
+    }
 
     auto &rfu = RedrawingFlagsUpdater::get_instance();
     if (old_mighty_throw != player_ptr->mighty_throw) {
@@ -835,7 +887,7 @@ static void update_max_mana(PlayerType *player_ptr)
     if (any_bits(mp_ptr->spell_xtra, extra_magic_glove_reduce_mana)) {
         player_ptr->cumber_glove = false;
         auto *o_ptr = &player_ptr->inventory_list[INVEN_ARMS];
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, INVEN_ARMS);
         auto should_mp_decrease = o_ptr->is_valid();
         should_mp_decrease &= flags.has_not(TR_FREE_ACT);
         should_mp_decrease &= flags.has_not(TR_DEC_MANA);
@@ -1060,7 +1112,7 @@ short calc_num_fire(PlayerType *player_ptr, const ItemEntity *o_ptr)
             continue;
         }
 
-        auto flags = object_flags(q_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (flags.has(TR_XTRA_SHOTS)) {
             extra_shots++;
         }
@@ -1177,7 +1229,7 @@ static ACTION_SKILL_POWER calc_device_ability(PlayerType *player_ptr)
         if (!o_ptr->is_valid()) {
             continue;
         }
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (flags.has(TR_MAGIC_MASTERY)) {
             pow += 8 * o_ptr->pval;
         }
@@ -1306,7 +1358,7 @@ static ACTION_SKILL_POWER calc_search(PlayerType *player_ptr)
         if (!o_ptr->is_valid()) {
             continue;
         }
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (flags.has(TR_SEARCH)) {
             pow += (o_ptr->pval * 5);
         }
@@ -1357,7 +1409,7 @@ static ACTION_SKILL_POWER calc_search_freq(PlayerType *player_ptr)
         if (!o_ptr->is_valid()) {
             continue;
         }
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (flags.has(TR_SEARCH)) {
             pow += (o_ptr->pval * 5);
         }
@@ -1495,7 +1547,7 @@ static ACTION_SKILL_POWER calc_skill_dig(PlayerType *player_ptr)
         if (!o_ptr->is_valid()) {
             continue;
         }
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (flags.has(TR_TUNNEL)) {
             pow += (o_ptr->pval * 20);
         }
@@ -1541,7 +1593,7 @@ static int16_t calc_num_blow(PlayerType *player_ptr, int i)
     int16_t num_blow = 1;
 
     o_ptr = &player_ptr->inventory_list[INVEN_MAIN_HAND + i];
-    auto flags = object_flags(o_ptr);
+    auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, INVEN_MAIN_HAND + i);
     PlayerClass pc(player_ptr);
     if (has_melee_weapon(player_ptr, INVEN_MAIN_HAND + i)) {
         if (o_ptr->is_valid() && !player_ptr->heavy_wield[i]) {
@@ -1788,7 +1840,7 @@ static ARMOUR_CLASS calc_to_ac(PlayerType *player_ptr, bool is_real_value)
     for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
         ItemEntity *o_ptr;
         o_ptr = &player_ptr->inventory_list[i];
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, i);
         if (!o_ptr->is_valid()) {
             continue;
         }
@@ -1796,7 +1848,7 @@ static ARMOUR_CLASS calc_to_ac(PlayerType *player_ptr, bool is_real_value)
             ac += o_ptr->to_a;
         }
 
-        if (o_ptr->curse_flags.has(CurseTraitType::LOW_AC) || object_flags(o_ptr).has(TR_LOW_AC)) {
+        if (o_ptr->curse_flags.has(CurseTraitType::LOW_AC) || flags.has(TR_LOW_AC)) {
             if (o_ptr->curse_flags.has(CurseTraitType::HEAVY_CURSE)) {
                 if (is_real_value || o_ptr->is_fully_known()) {
                     ac -= 30;
@@ -1944,7 +1996,7 @@ int16_t calc_double_weapon_penalty(PlayerType *player_ptr, INVENTORY_IDX slot)
     int penalty = 0;
 
     if (has_melee_weapon(player_ptr, INVEN_MAIN_HAND) && has_melee_weapon(player_ptr, INVEN_SUB_HAND)) {
-        auto flags = object_flags(&player_ptr->inventory_list[INVEN_SUB_HAND]);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, INVEN_SUB_HAND);
 
         penalty = ((100 - player_ptr->skill_exp[PlayerSkillKindType::TWO_WEAPON] / 160) - (130 - player_ptr->inventory_list[slot].weight) / 8);
         if (set_quick_and_tiny(player_ptr) || set_icing_and_twinkle(player_ptr) || set_anubis_and_chariot(player_ptr)) {
@@ -2127,7 +2179,7 @@ static bool is_bare_knuckle(PlayerType *player_ptr)
 static short calc_to_damage(PlayerType *player_ptr, INVENTORY_IDX slot, bool is_real_value)
 {
     auto *o_ptr = &player_ptr->inventory_list[slot];
-    auto flags = object_flags(o_ptr);
+    auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, slot);
 
     player_hand calc_hand = PLAYER_HAND_OTHER;
     if (slot == INVEN_MAIN_HAND) {
@@ -2344,7 +2396,7 @@ static short calc_to_hit(PlayerType *player_ptr, INVENTORY_IDX slot, bool is_rea
     PlayerClass pc(player_ptr);
     if (has_melee_weapon(player_ptr, slot)) {
         auto *o_ptr = &player_ptr->inventory_list[slot];
-        auto flags = object_flags(o_ptr);
+        auto flags = EquipmentFlagsCache::get_instance().get_slot_flags(player_ptr, slot);
 
         /* Traind bonuses */
         const auto tval = o_ptr->bi_key.tval();
@@ -2716,13 +2768,20 @@ void update_creature(PlayerType *player_ptr)
         reorder_pack(player_ptr);
     }
 
-    if (rfu.has(StatusRecalculatingFlag::BONUS)) {
-        rfu.reset_flag(StatusRecalculatingFlag::BONUS);
+    EnumClassFlagGroup<BonusFieldType> bonus_fields;
+    for (const auto &[flag, fields] : BONUS_DEPENDENCIES) {
+        if (rfu.has(flag)) {
+            rfu.reset_flag(flag);
+            bonus_fields.set(fields);
+        }
+    }
+
+    if (bonus_fields.any()) {
         PlayerAlignment(player_ptr).update_alignment();
         PlayerSkill ps(player_ptr);
         ps.apply_special_weapon_skill_max_values();
         ps.limit_weapon_skills_by_max_value();
-        update_bonuses(player_ptr);
+        update_bonuses(player_ptr, bonus_fields);
     }
 
     if (rfu.has(StatusRecalculatingFlag::TORCH)) {
@@ -8,8 +8,75 @@
 #include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
 #include "util/point-2d.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 
+namespace {
+/*!
+ * @brief 視界計算で帯 (strip) を伸ばしていく八分円の向き
+ * @details 帯は主軸 axis 方向に伸び、帯の番号が1増えるごとに side 方向へ1マスずれる.
+ * 主軸 axis の直線上にある2つの八分円は、初期の走査上限として同じ主軸の視線の長さを共有する.
+ */
+struct ViewOctant {
+    Pos2D axis;
+    Pos2D side;
+};
+
+/*!
+ * @brief 八分円の走査順 (南東・南西・北東・北西・東南・東北・西南・西北)
+ * @details 0～3番目は南北方向、4～7番目は東西方向に帯を伸ばす.
+ */
+constexpr std::array<ViewOctant, 8> VIEW_OCTANTS = { {
+    { { 1, 0 }, { 0, 1 } },
+    { { 1, 0 }, { 0, -1 } },
+    { { -1, 0 }, { 0, 1 } },
+    { { -1, 0 }, { 0, -1 } },
+    { { 0, 1 }, { 1, 0 } },
+    { { 0, 1 }, { -1, 0 } },
+    { { 0, -1 }, { 1, 0 } },
+    { { 0, -1 }, { -1, 0 } },
+} };
+
+//! 主軸方向 (南・北・東・西). VIEW_OCTANTS[i] の主軸は VIEW_AXES[i / 2] に等しい.
+constexpr std::array<Pos2D, 4> VIEW_AXES = { { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } } };
+
+//! 対角方向 (南東・南西・北東・北西)
+constexpr std::array<Pos2D, 4> VIEW_DIAGONALS = { { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } } };
+
+constexpr auto MAX_VIEW_STRIPS = MAX_PLAYER_SIGHT * 3 / 4;
+
+/*!
+ * @brief 視界の広さごとの走査範囲表
+ * @details strip_lengths[n] は n 番目の帯を主軸方向へ伸ばす最大の長さ.
+ */
+struct ViewRange {
+    int full;
+    int over;
+    std::array<int, MAX_VIEW_STRIPS + 1> strip_lengths;
+};
+
+constexpr ViewRange make_view_range(int full, int over)
+{
+    ViewRange range{ full, over, {} };
+    for (auto n = 1; n <= over / 2; n++) {
+        auto z = std::min(over - n - n, full - n);
+        while ((z + n + (n >> 1)) > full) {
+            z--;
+        }
+
+        range.strip_lengths[n] = z;
+    }
+
+    return range;
+}
+
+constexpr auto VIEW_RANGE_NORMAL = make_view_range(MAX_PLAYER_SIGHT, MAX_PLAYER_SIGHT * 3 / 2);
+constexpr auto VIEW_RANGE_REDUCED = make_view_range(MAX_PLAYER_SIGHT / 2, MAX_PLAYER_SIGHT * 3 / 4);
+static_assert(VIEW_RANGE_NORMAL.over / 2 <= MAX_VIEW_STRIPS);
+static_assert(VIEW_RANGE_REDUCED.over / 2 <= MAX_VIEW_STRIPS);
+}
+
 /*
  * Helper function for "update_view()" below
  *
@@ -17,8 +84,8 @@
  *
  * This function assumes that (y,x) is legal (i.e. on the map).
  *
- * Grid (y1,x1) is on the "diagonal" between (player_ptr->y,player_ptr->x) and (y,x)
- * Grid (y2,x2) is "adjacent", also between (player_ptr->y,player_ptr->x) and (y,x).
+ * Grid pos_diagonal is on the "diagonal" between (player_ptr->y,player_ptr->x) and (y,x)
+ * Grid pos_adjacent is "adjacent", also between (player_ptr->y,player_ptr->x) and (y,x).
  *
  * Note that we are using the "CAVE_XTRA" field for marking grids as
  * "easily viewable".  This bit is cleared at the end of "update_view()".
@@ -27,13 +94,11 @@
  *
  * This function now returns "TRUE" if vision is "blocked" by grid (y,x).
  */
-static bool update_view_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+static bool update_view_aux(PlayerType *player_ptr, const Pos2D &pos, const Pos2D &pos_diagonal, const Pos2D &pos_adjacent)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    grid_type *g1_c_ptr;
-    grid_type *g2_c_ptr;
-    g1_c_ptr = &floor_ptr->grid_array[y1][x1];
-    g2_c_ptr = &floor_ptr->grid_array[y2][x2];
+    auto *g1_c_ptr = &floor_ptr->get_grid(pos_diagonal);
+    auto *g2_c_ptr = &floor_ptr->get_grid(pos_adjacent);
     bool f1 = (feat_supports_los(g1_c_ptr->feat));
     bool f2 = (feat_supports_los(g2_c_ptr->feat));
     if (!f1 && !f2) {
@@ -46,40 +111,84 @@ static bool update_view_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSI
         return true;
     }
 
-    grid_type *g_ptr;
-    g_ptr = &floor_ptr->grid_array[y][x];
+    auto *g_ptr = &floor_ptr->get_grid(pos);
     bool wall = (!feat_supports_los(g_ptr->feat));
     bool z1 = (v1 && (g1_c_ptr->info & CAVE_XTRA));
     bool z2 = (v2 && (g2_c_ptr->info & CAVE_XTRA));
     if (z1 && z2) {
         g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x);
+        cave_view_hack(floor_ptr, pos.y, pos.x);
         return wall;
     }
 
     if (z1) {
-        cave_view_hack(floor_ptr, y, x);
+        cave_view_hack(floor_ptr, pos.y, pos.x);
         return wall;
     }
 
     if (v1 && v2) {
-        cave_view_hack(floor_ptr, y, x);
+        cave_view_hack(floor_ptr, pos.y, pos.x);
         return wall;
     }
 
     if (wall) {
-        cave_view_hack(floor_ptr, y, x);
+        cave_view_hack(floor_ptr, pos.y, pos.x);
         return wall;
     }
 
-    if (los(player_ptr, player_ptr->y, player_ptr->x, y, x)) {
-        cave_view_hack(floor_ptr, y, x);
+    if (los(player_ptr, player_ptr->y, player_ptr->x, pos.y, pos.x)) {
+        cave_view_hack(floor_ptr, pos.y, pos.x);
         return wall;
     }
 
     return true;
 }
 
+/*!
+ * @brief プレイヤーから直線上に最初の壁まで視界を通す (対角線・主軸の処理)
+ * @param floor_ptr フロアへの参照ポインタ
+ * @param p_pos プレイヤーの座標
+ * @param dir 視線の方向
+ * @param length 視線の最大長
+ * @return 最初に視界を遮ったマスまでの距離. 遮られなかった場合は length + 1
+ */
+static int update_view_ray(FloorType *floor_ptr, const Pos2D &p_pos, const Pos2D &dir, int length)
+{
+    auto d = 1;
+    for (; d <= length; d++) {
+        const Pos2D pos(p_pos.y + dir.y * d, p_pos.x + dir.x * d);
+        auto &grid = floor_ptr->get_grid(pos);
+        grid.info |= CAVE_XTRA;
+        cave_view_hack(floor_ptr, pos.y, pos.x);
+        if (!feat_supports_los(grid.feat)) {
+            break;
+        }
+    }
+
+    return d;
+}
+
+/*!
+ * @brief 主軸方向の残りの長さを返す
+ * @param pos 帯の起点
+ * @param dir 主軸方向
+ * @param y_max フロアのY座標の最大値
+ * @param x_max フロアのX座標の最大値
+ * @return 起点からフロアの端までのマス数
+ */
+static int remaining_length(const Pos2D &pos, const Pos2D &dir, POSITION y_max, POSITION x_max)
+{
+    if (dir.y > 0) {
+        return y_max - pos.y;
+    }
+
+    if (dir.y < 0) {
+        return pos.y;
+    }
+
+    return (dir.x > 0) ? x_max - pos.x : pos.x;
+}
+
 /*
  * Calculate the viewable space
  *
@@ -97,272 +206,84 @@ static bool update_view_aux(PlayerType *player_ptr, POSITION y, POSITION x, POSI
  *  4c: Process both "sides" of each "direction" of each strip
  *  4c1: Each side aborts as soon as possible
  *  4c2: Each side tells the next strip how far it has to check
+ *
+ * 八分円ごとの向きと帯の長さは VIEW_OCTANTS / ViewRange の表から引く.
  */
 void update_view(PlayerType *player_ptr)
 {
-    // 前回プレイヤーから見えていた座標たちを格納する配列。
-    std::vector<Pos2D> points;
-
-    int n, m, d, k, z;
-    POSITION y, x;
-
-    int se, sw, ne, nw, es, en, ws, wn;
-
-    int full, over;
+    // 前回プレイヤーから見えていた座標たちを格納する配列。呼び出しを跨いで領域を再利用する.
+    static std::vector<Pos2D> points;
+    points.clear();
 
     auto *floor_ptr = player_ptr->current_floor_ptr;
-    POSITION y_max = floor_ptr->height - 1;
-    POSITION x_max = floor_ptr->width - 1;
-
-    grid_type *g_ptr;
-    if (view_reduce_view && !floor_ptr->dun_level) {
-        full = MAX_PLAYER_SIGHT / 2;
-        over = MAX_PLAYER_SIGHT * 3 / 4;
-    } else {
-        full = MAX_PLAYER_SIGHT;
-        over = MAX_PLAYER_SIGHT * 3 / 2;
-    }
-
-    for (n = 0; n < floor_ptr->view_n; n++) {
-        y = floor_ptr->view_y[n];
-        x = floor_ptr->view_x[n];
-        g_ptr = &floor_ptr->grid_array[y][x];
-        g_ptr->info &= ~(CAVE_VIEW);
-        g_ptr->info |= CAVE_TEMP;
-
-        points.emplace_back(y, x);
+    const POSITION y_max = floor_ptr->height - 1;
+    const POSITION x_max = floor_ptr->width - 1;
+    const auto &range = (view_reduce_view && !floor_ptr->dun_level) ? VIEW_RANGE_REDUCED : VIEW_RANGE_NORMAL;
+
+    for (auto n = 0; n < floor_ptr->view_n; n++) {
+        const Pos2D pos(floor_ptr->view_y[n], floor_ptr->view_x[n]);
+        auto &grid = floor_ptr->get_grid(pos);
+        grid.info &= ~(CAVE_VIEW);
+        grid.info |= CAVE_TEMP;
+        points.push_back(pos);
     }
 
     floor_ptr->view_n = 0;
-    y = player_ptr->y;
-    x = player_ptr->x;
-    g_ptr = &floor_ptr->grid_array[y][x];
-    g_ptr->info |= CAVE_XTRA;
-    cave_view_hack(floor_ptr, y, x);
-
-    z = full * 2 / 3;
-    for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
-
-    for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
+    const Pos2D p_pos(player_ptr->y, player_ptr->x);
+    floor_ptr->get_grid(p_pos).info |= CAVE_XTRA;
+    cave_view_hack(floor_ptr, p_pos.y, p_pos.x);
 
-    for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
+    for (const auto &dir : VIEW_DIAGONALS) {
+        update_view_ray(floor_ptr, p_pos, dir, range.full * 2 / 3);
     }
 
-    for (d = 1; d <= z; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
+    // 各八分円で次の帯が確認すべき距離. 初期値は同じ主軸方向の視線の長さ.
+    std::array<int, VIEW_OCTANTS.size()> limits{};
+    for (size_t i = 0; i < VIEW_AXES.size(); i++) {
+        limits[i * 2] = limits[i * 2 + 1] = update_view_ray(floor_ptr, p_pos, VIEW_AXES[i], range.full);
     }
 
-    for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y + d][x];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y + d, x);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
-
-    se = sw = d;
-    for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y - d][x];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y - d, x);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
-
-    ne = nw = d;
-    for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y][x + d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x + d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
-
-    es = en = d;
-    for (d = 1; d <= full; d++) {
-        g_ptr = &floor_ptr->grid_array[y][x - d];
-        g_ptr->info |= CAVE_XTRA;
-        cave_view_hack(floor_ptr, y, x - d);
-        if (!feat_supports_los(g_ptr->feat)) {
-            break;
-        }
-    }
-
-    ws = wn = d;
-    for (n = 1; n <= over / 2; n++) {
-        POSITION ypn, ymn, xpn, xmn;
-        z = over - n - n;
-        if (z > full - n) {
-            z = full - n;
-        }
-
-        while ((z + n + (n >> 1)) > full) {
-            z--;
-        }
-
-        ypn = y + n;
-        ymn = y - n;
-        xpn = x + n;
-        xmn = x - n;
-        if (ypn < y_max) {
-            m = std::min(z, y_max - ypn);
-            if ((xpn <= x_max) && (n < se)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ypn + d, xpn, ypn + d - 1, xpn - 1, ypn + d - 1, xpn)) {
-                        if (n + d >= se) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                se = k + 1;
-            }
-
-            if ((xmn >= 0) && (n < sw)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ypn + d, xmn, ypn + d - 1, xmn + 1, ypn + d - 1, xmn)) {
-                        if (n + d >= sw) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                sw = k + 1;
-            }
-        }
-
-        if (ymn > 0) {
-            m = std::min(z, ymn);
-            if ((xpn <= x_max) && (n < ne)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ymn - d, xpn, ymn - d + 1, xpn - 1, ymn - d + 1, xpn)) {
-                        if (n + d >= ne) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                ne = k + 1;
-            }
-
-            if ((xmn >= 0) && (n < nw)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ymn - d, xmn, ymn - d + 1, xmn + 1, ymn - d + 1, xmn)) {
-                        if (n + d >= nw) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                nw = k + 1;
-            }
-        }
-
-        if (xpn < x_max) {
-            m = std::min(z, x_max - xpn);
-            if ((ypn <= x_max) && (n < es)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ypn, xpn + d, ypn - 1, xpn + d - 1, ypn, xpn + d - 1)) {
-                        if (n + d >= es) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                es = k + 1;
+    for (auto n = 1; n <= range.over / 2; n++) {
+        const auto z = range.strip_lengths[n];
+        for (size_t i = 0; i < VIEW_OCTANTS.size(); i++) {
+            const auto &[axis, side] = VIEW_OCTANTS[i];
+            auto &limit = limits[i];
+            const Pos2D base(p_pos.y + (axis.y + side.y) * n, p_pos.x + (axis.x + side.x) * n);
+            const auto remaining = remaining_length(base, axis, y_max, x_max);
+            if (remaining <= 0) {
+                continue;
             }
 
-            if ((ymn >= 0) && (n < en)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ymn, xpn + d, ymn + 1, xpn + d - 1, ymn, xpn + d - 1)) {
-                        if (n + d >= en) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                en = k + 1;
+            const auto is_side_in_bounds = (side.y != 0) ? ((base.y >= 0) && (base.y <= y_max)) : ((base.x >= 0) && (base.x <= x_max));
+            if (!is_side_in_bounds || (n >= limit)) {
+                continue;
             }
-        }
 
-        if (xmn > 0) {
-            m = std::min(z, xmn);
-            if ((ypn <= y_max) && (n < ws)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ypn, xmn - d, ypn - 1, xmn - d + 1, ypn, xmn - d + 1)) {
-                        if (n + d >= ws) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
+            const auto m = std::min(z, remaining);
+            auto k = n;
+            for (auto d = 1; d <= m; d++) {
+                const Pos2D pos(base.y + axis.y * d, base.x + axis.x * d);
+                const Pos2D pos_adjacent(pos.y - axis.y, pos.x - axis.x);
+                const Pos2D pos_diagonal(pos_adjacent.y - side.y, pos_adjacent.x - side.x);
+                if (update_view_aux(player_ptr, pos, pos_diagonal, pos_adjacent)) {
+                    if (n + d >= limit) {
+                        break;
                     }
+                } else {
+                    k = n + d;
                 }
-
-                ws = k + 1;
             }
 
-            if ((ymn >= 0) && (n < wn)) {
-                for (k = n, d = 1; d <= m; d++) {
-                    if (update_view_aux(player_ptr, ymn, xmn - d, ymn + 1, xmn - d + 1, ymn, xmn - d + 1)) {
-                        if (n + d >= wn) {
-                            break;
-                        }
-                    } else {
-                        k = n + d;
-                    }
-                }
-
-                wn = k + 1;
-            }
+            limit = k + 1;
         }
     }
 
-    for (n = 0; n < floor_ptr->view_n; n++) {
-        y = floor_ptr->view_y[n];
-        x = floor_ptr->view_x[n];
-        g_ptr = &floor_ptr->grid_array[y][x];
-        g_ptr->info &= ~(CAVE_XTRA);
-        if (g_ptr->info & CAVE_TEMP) {
+    for (auto n = 0; n < floor_ptr->view_n; n++) {
+        const auto y = floor_ptr->view_y[n];
+        const auto x = floor_ptr->view_x[n];
+        auto &grid = floor_ptr->grid_array[y][x];
+        grid.info &= ~(CAVE_XTRA);
+        if (grid.info & CAVE_TEMP) {
             continue;
         }
 
@@ -370,9 +291,9 @@ void update_view(PlayerType *player_ptr)
     }
 
     for (const auto &[py, px] : points) {
-        g_ptr = &floor_ptr->grid_array[py][px];
-        g_ptr->info &= ~(CAVE_TEMP);
-        if (g_ptr->info & CAVE_VIEW) {
+        auto &grid = floor_ptr->grid_array[py][px];
+        grid.info &= ~(CAVE_TEMP);
+        if (grid.info & CAVE_VIEW) {
             continue;
         }
 
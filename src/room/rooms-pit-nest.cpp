@@ -30,6 +30,7 @@
 #include "view/display-messages.h"
 #include "wizard/wizard-messages.h"
 #include <optional>
+#include <tuple>
 #include <vector>
 
 /*!
@@ -109,72 +110,15 @@ static std::string pit_subtype_string(int type, bool nest)
     return std::string();
 }
 
-/*
- *! @brief nestのモンスターリストをソートするための関数 /
- *  Comp function for sorting nest monster information
- *  @param u ソート処理対象配列ポインタ
- *  @param v 未使用
- *  @param a 比較対象参照ID1
- *  @param b 比較対象参照ID2
- *  TODO: to sort.c
- */
-static bool ang_sort_comp_nest_mon_info(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    auto w1 = nest_mon_info[a].r_idx;
-    auto w2 = nest_mon_info[b].r_idx;
-    MonsterRaceInfo *r1_ptr = &monraces_info[w1];
-    MonsterRaceInfo *r2_ptr = &monraces_info[w2];
-    int z1 = nest_mon_info[a].used;
-    int z2 = nest_mon_info[b].used;
-
-    if (z1 < z2) {
-        return false;
-    }
-    if (z1 > z2) {
-        return true;
-    }
-
-    if (r1_ptr->level < r2_ptr->level) {
-        return true;
-    }
-    if (r1_ptr->level > r2_ptr->level) {
-        return false;
-    }
-
-    if (r1_ptr->mexp < r2_ptr->mexp) {
-        return true;
-    }
-    if (r1_ptr->mexp > r2_ptr->mexp) {
-        return false;
-    }
-
-    return w1 <= w2;
-}
-
 /*!
- * @brief nestのモンスターリストをスワップするための関数 /
- * Swap function for sorting nest monster information
- * @param u スワップ処理対象配列ポインタ
- * @param v 未使用
- * @param a スワップ対象参照ID1
- * @param b スワップ対象参照ID2
- * TODO: to sort.c
+ * @brief nestのモンスターリストを並べ替えるためのキーを返す
+ * @param info nestのモンスター情報
+ * @return 並べ替えのキー (配置したモンスター、低レベル、低経験値、種族IDの順)
  */
-static void ang_sort_swap_nest_mon_info(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+static std::tuple<bool, int, int, MonsterRaceId> calc_nest_mon_info_key(const nest_mon_info_type &info)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    nest_mon_info_type holder = nest_mon_info[a];
-    nest_mon_info[a] = nest_mon_info[b];
-    nest_mon_info[b] = holder;
+    const auto &monrace = monraces_info[info.r_idx];
+    return std::make_tuple(!info.used, monrace.level, monrace.mexp, info.r_idx);
 }
 
 /*!
@@ -388,7 +332,7 @@ bool build_type5(PlayerType *player_ptr, dun_data_type *dd_ptr)
     }
 
     if (cheat_room) {
-        ang_sort(player_ptr, nest_mon_info, nullptr, NUM_NEST_MON_TYPE, ang_sort_comp_nest_mon_info, ang_sort_swap_nest_mon_info);
+        sort_by_key(std::begin(nest_mon_info), std::end(nest_mon_info), calc_nest_mon_info_key);
 
         /* Dump the entries (prevent multi-printing) */
         for (i = 0; i < NUM_NEST_MON_TYPE; i++) {
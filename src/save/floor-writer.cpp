@@ -4,8 +4,6 @@
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
 #include "grid/grid.h"
-#include "io/files-util.h"
-#include "io/uid-checker.h"
 #include "load/floor-loader.h"
 #include "monster-floor/monster-lite.h"
 #include "monster/monster-compaction.h"
@@ -15,9 +13,8 @@
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/item-entity.h"
+#include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
-#include "term/z-form.h"
-#include "util/angband-files.h"
 #include "util/sort.h"
 
 /*!
@@ -78,8 +75,7 @@ void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
         }
     }
 
-    int dummy_why;
-    ang_sort(player_ptr, templates.data(), &dummy_why, templates.size(), ang_sort_comp_cave_temp, ang_sort_swap_cave_temp);
+    sort_grid_templates(templates);
 
     /*** Dump templates ***/
     wr_u16b(static_cast<uint16_t>(templates.size()));
@@ -211,7 +207,7 @@ bool wr_dungeon(PlayerType *player_ptr)
 }
 
 /*!
- * @brief ゲームプレイ中のフロア一時保存出力処理サブルーチン / Actually write a temporary saved floor file
+ * @brief ゲームプレイ中のフロア一時保存出力処理サブルーチン / Actually write a temporary saved floor data
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param sf_ptr 保存フロア参照ポインタ
  */
@@ -221,76 +217,57 @@ static bool save_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
     compact_monsters(player_ptr, 0);
 
     byte tmp8u = (byte)randint0(256);
-    save_xor_byte = 0;
+    reset_save_xor_byte();
     wr_byte(tmp8u);
 
     /* Reset the checksum */
-    v_stamp = 0L;
-    x_stamp = 0L;
+    reset_save_checksums();
     wr_u32b(saved_floor_file_sign);
     wr_saved_floor(player_ptr, sf_ptr);
-    wr_u32b(v_stamp);
-    wr_u32b(x_stamp);
+    wr_save_checksums();
 
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
+    return flush_savefile();
 }
+
 /*!
  * @brief ゲームプレイ中のフロア一時保存出力処理メインルーチン / Attempt to save the temporarily saved-floor data
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param sf_ptr 保存フロア参照ポインタ
  * @param mode 保存オプション
+ * @details 保存したフロアは一時ファイルではなく saved_floor_images にメモリ上で圧縮して保持する.
+ * ディスクに書き出されるのはセーブファイル全体を保存する時 (wr_dungeon()) のみである.
  */
 bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode)
 {
     FILE *old_fff = nullptr;
+    std::vector<byte> *old_image = nullptr;
     byte old_xor_byte = 0;
     uint32_t old_v_stamp = 0;
     uint32_t old_x_stamp = 0;
 
     if ((mode & SLF_SECOND) != 0) {
+        flush_savefile_buffer();
         old_fff = saving_savefile;
+        old_image = saving_savefile_image;
         old_xor_byte = save_xor_byte;
         old_v_stamp = v_stamp;
         old_x_stamp = x_stamp;
     }
 
-    auto floor_savefile = savefile.string();
-    char ext[32];
-    strnfmt(ext, sizeof(ext), ".F%02d", (int)sf_ptr->savefile_id);
-    floor_savefile.append(ext);
-    safe_setuid_grab();
-    fd_kill(floor_savefile);
-    safe_setuid_drop();
+    auto &image = saved_floor_images[sf_ptr->savefile_id];
+    image.clear();
+    std::vector<byte> bytes;
     saving_savefile = nullptr;
-    safe_setuid_grab();
-
-    auto fd = fd_make(floor_savefile);
-    safe_setuid_drop();
-    bool is_save_successful = false;
-    if (fd >= 0) {
-        (void)fd_close(fd);
-        safe_setuid_grab();
-        saving_savefile = angband_fopen(floor_savefile, FileOpenMode::WRITE, true);
-        safe_setuid_drop();
-        if (saving_savefile) {
-            if (save_floor_aux(player_ptr, sf_ptr)) {
-                is_save_successful = true;
-            }
-
-            if (angband_fclose(saving_savefile)) {
-                is_save_successful = false;
-            }
-        }
-
-        if (!is_save_successful) {
-            safe_setuid_grab();
-            (void)fd_kill(floor_savefile);
-            safe_setuid_drop();
-        }
+    saving_savefile_image = &bytes;
+    const auto is_save_successful = save_floor_aux(player_ptr, sf_ptr);
+    if (is_save_successful) {
+        image.store(bytes);
     }
 
+    saving_savefile_image = nullptr;
     if ((mode & SLF_SECOND) != 0) {
         saving_savefile = old_fff;
+        saving_savefile_image = old_image;
         save_xor_byte = old_xor_byte;
         v_stamp = old_v_stamp;
         x_stamp = old_x_stamp;
@@ -1,23 +1,139 @@
 ﻿#include "save/save-util.h"
+#include <bit>
+#include <cstring>
+#include <vector>
 
 FILE *saving_savefile; /* Current save "file" */
+std::vector<byte> *saving_savefile_image = nullptr; /*!< 書き込み先がメモリ上の場合の格納先. nullptr ならファイルに書き込む */
 byte save_xor_byte; /* Simple encryption */
 uint32_t v_stamp = 0L; /* A simple "checksum" on the actual values */
 uint32_t x_stamp = 0L; /* A simple "checksum" on the encoded bytes */
 
+namespace {
+constexpr size_t SAVEFILE_BUFFER_SIZE = 64 * 1024; /*!< 符号化前のバイト列を溜めておく最大量 */
+
+/*!
+ * @brief 未だ符号化・書き込みしていないバイト列
+ * @details save_xor_byte, v_stamp, x_stamp にはここに溜まっているバイトの分が反映されていない.
+ */
+std::vector<byte> savefile_buffer;
+}
+
+/*!
+ * @brief 溜めておいたバイト列をまとめて符号化し、ファイルに書き込む
+ * @details 溜まっていなければ何もしない. save_xor_byte, v_stamp, x_stamp を直接参照・変更する前に呼ぶこと.
+ * 1バイトずつ符号化していた頃と全く同じバイト列とチェックサムになる.
+ * 暗号化は直前の暗号化済みバイトとのXORの連鎖であるため、8バイト単位で累積XORを取って処理する.
+ * チェックサムの加算はループ間に依存がないため、コンパイラによるベクトル化が効く.
+ */
+void flush_savefile_buffer()
+{
+    if (savefile_buffer.empty()) {
+        return;
+    }
+
+    uint32_t value_sum = 0;
+    for (const auto v : savefile_buffer) {
+        value_sum += v;
+    }
+
+    auto xor_byte = save_xor_byte;
+    size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; i + sizeof(uint64_t) <= savefile_buffer.size(); i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, &savefile_buffer[i], sizeof(word));
+            word ^= word << 8;
+            word ^= word << 16;
+            word ^= word << 32;
+            word ^= 0x0101010101010101ULL * xor_byte;
+            xor_byte = static_cast<byte>(word >> 56);
+            std::memcpy(&savefile_buffer[i], &word, sizeof(word));
+        }
+    }
+
+    for (; i < savefile_buffer.size(); i++) {
+        xor_byte ^= savefile_buffer[i];
+        savefile_buffer[i] = xor_byte;
+    }
+
+    uint32_t encoded_sum = 0;
+    for (const auto v : savefile_buffer) {
+        encoded_sum += v;
+    }
+
+    save_xor_byte = xor_byte;
+    v_stamp += value_sum;
+    x_stamp += encoded_sum;
+    if (saving_savefile_image != nullptr) {
+        saving_savefile_image->insert(saving_savefile_image->end(), savefile_buffer.begin(), savefile_buffer.end());
+    } else {
+        (void)fwrite(savefile_buffer.data(), 1, savefile_buffer.size(), saving_savefile);
+    }
+
+    savefile_buffer.clear();
+}
+
 /*!
  * @brief 1バイトをファイルに書き込む / These functions place information into a savefile a byte at a time
  * @param v 書き込むバイト値
+ * @details 実際にはバッファに溜めておき、一定量溜まった時点でまとめて符号化・書き込みする.
  */
 static void sf_put(byte v)
 {
-    /* Encode the value, write a character */
-    save_xor_byte ^= v;
-    (void)putc((int)save_xor_byte, saving_savefile);
+    if (savefile_buffer.capacity() < SAVEFILE_BUFFER_SIZE) {
+        savefile_buffer.reserve(SAVEFILE_BUFFER_SIZE);
+    }
+
+    savefile_buffer.push_back(v);
+    if (savefile_buffer.size() >= SAVEFILE_BUFFER_SIZE) {
+        flush_savefile_buffer();
+    }
+}
+
+/*!
+ * @brief 暗号化用のXOR値を初期化する
+ */
+void reset_save_xor_byte()
+{
+    flush_savefile_buffer();
+    save_xor_byte = 0;
+}
+
+/*!
+ * @brief チェックサムを初期化する
+ */
+void reset_save_checksums()
+{
+    flush_savefile_buffer();
+    v_stamp = 0L;
+    x_stamp = 0L;
+}
+
+/*!
+ * @brief チェックサムをファイルに書き込む
+ * @details x_stamp には書き込んだ v_stamp の符号化後の値も含まれる.
+ */
+void wr_save_checksums()
+{
+    flush_savefile_buffer();
+    wr_u32b(v_stamp);
+    flush_savefile_buffer();
+    wr_u32b(x_stamp);
+}
+
+/*!
+ * @brief 溜めておいたバイト列を全てファイルに書き出す
+ * @return 書き込みに成功したか
+ */
+bool flush_savefile()
+{
+    flush_savefile_buffer();
+    if (saving_savefile_image != nullptr) {
+        return true;
+    }
 
-    /* Maintain the checksum info */
-    v_stamp += v;
-    x_stamp += save_xor_byte;
+    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
 }
 
 /*!
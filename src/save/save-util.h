@@ -2,12 +2,20 @@
 
 #include "system/angband.h"
 #include <string_view>
+#include <vector>
 
 extern FILE *saving_savefile;
+extern std::vector<byte> *saving_savefile_image;
 extern byte save_xor_byte;
 extern uint32_t v_stamp;
 extern uint32_t x_stamp;
 
+void reset_save_xor_byte();
+void reset_save_checksums();
+void wr_save_checksums();
+void flush_savefile_buffer();
+bool flush_savefile();
+
 void wr_bool(bool v);
 void wr_byte(byte v);
 void wr_u16b(uint16_t v);
@@ -62,15 +62,15 @@ static bool wr_savefile_new(PlayerType *player_ptr, SaveType type)
     w_ptr->sf_when = now;
     w_ptr->sf_saves++;
 
-    save_xor_byte = 0;
+    reset_save_xor_byte();
     auto variant_length = VARIANT_NAME.length();
     wr_byte(static_cast<byte>(variant_length));
     for (auto i = 0U; i < variant_length; i++) {
-        save_xor_byte = 0;
+        reset_save_xor_byte();
         wr_byte(VARIANT_NAME[i]);
     }
 
-    save_xor_byte = 0;
+    reset_save_xor_byte();
     wr_byte(H_VER_MAJOR);
     wr_byte(H_VER_MINOR);
     wr_byte(H_VER_PATCH);
@@ -78,8 +78,7 @@ static bool wr_savefile_new(PlayerType *player_ptr, SaveType type)
 
     byte tmp8u = (byte)Rand_external(256);
     wr_byte(tmp8u);
-    v_stamp = 0L;
-    x_stamp = 0L;
+    reset_save_checksums();
 
     wr_u32b(w_ptr->sf_system);
     wr_u32b(w_ptr->sf_when);
@@ -235,6 +234,7 @@ static bool wr_savefile_new(PlayerType *player_ptr, SaveType type)
 
     if (!player_ptr->is_dead) {
         if (!wr_dungeon(player_ptr)) {
+            (void)flush_savefile();
             return false;
         }
 
@@ -242,9 +242,8 @@ static bool wr_savefile_new(PlayerType *player_ptr, SaveType type)
         wr_s32b(0);
     }
 
-    wr_u32b(v_stamp);
-    wr_u32b(x_stamp);
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
+    wr_save_checksums();
+    return flush_savefile();
 }
 
 /*!
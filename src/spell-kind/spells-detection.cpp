@@ -204,6 +204,7 @@ bool detect_objects_gold(PlayerType *player_ptr, POSITION range)
 
         if (o_ptr->bi_key.tval() == ItemKindType::GOLD) {
             o_ptr->marked.set(OmType::FOUND);
+            floor.found_item_index.add(i);
             lite_spot(player_ptr, y, x);
             detect = true;
         }
@@ -257,6 +258,7 @@ bool detect_objects_normal(PlayerType *player_ptr, POSITION range)
 
         if (o_ptr->bi_key.tval() != ItemKindType::GOLD) {
             o_ptr->marked.set(OmType::FOUND);
+            floor.found_item_index.add(i);
             lite_spot(player_ptr, y, x);
             detect = true;
         }
@@ -324,6 +326,7 @@ bool detect_objects_magic(PlayerType *player_ptr, POSITION range)
         has_bonus |= o_ptr->to_h + o_ptr->to_d > 0;
         if (o_ptr->is_fixed_or_random_artifact() || o_ptr->is_ego() || is_object_magically(o_ptr->bi_key.tval()) || o_ptr->is_spell_book() || has_bonus) {
             o_ptr->marked.set(OmType::FOUND);
+            floor.found_item_index.add(i);
             lite_spot(player_ptr, y, x);
             detect = true;
         }
@@ -73,6 +73,7 @@ void wiz_lite(PlayerType *player_ptr, bool ninja)
             continue;
         }
         o_ptr->marked.set(OmType::FOUND);
+        floor.found_item_index.add(i);
     }
 
     /* Scan all normal grids */
@@ -411,6 +412,7 @@ bool destroy_area(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION r,
                 continue;
             }
 
+            floor_ptr->terrain_generation++;
             if (t < 20) {
                 /* Create granite wall */
                 place_grid(player_ptr, g_ptr, GB_EXTRA);
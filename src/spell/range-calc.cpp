@@ -16,6 +16,32 @@
 #include "target/projection-path-calculator.h"
 #include "util/bit-flags-calculator.h"
 
+/*!
+ * @brief 中心からの距離が指定値に等しいマスへの相対座標の一覧を返す
+ * @param dist 中心からの距離
+ * @return 相対座標の一覧 (y, x の昇順)
+ * @details
+ * 球やブレスの効果範囲を求める時に、正方形内の全マスについて distance() を計算し直さずに済むよう、
+ * 距離毎に初回だけ計算した一覧を保持しておく.
+ */
+const std::vector<Pos2D> &get_ring_offsets(int dist)
+{
+    static std::vector<std::vector<Pos2D>> ring_offsets;
+    while (static_cast<int>(ring_offsets.size()) <= dist) {
+        const auto d = static_cast<int>(ring_offsets.size());
+        auto &offsets = ring_offsets.emplace_back();
+        for (auto y = -d; y <= d; y++) {
+            for (auto x = -d; x <= d; x++) {
+                if (distance(0, 0, y, x) == d) {
+                    offsets.emplace_back(y, x);
+                }
+            }
+        }
+    }
+
+    return ring_offsets[dist];
+}
+
 /*
  * Find the distance from (x, y) to a line.
  */
@@ -224,44 +250,41 @@ void breath_shape(PlayerType *player_ptr, const projection_path &path, int dist,
 
         /* Travel from center outward */
         for (cdis = 0; cdis <= brad; cdis++) {
-            for (POSITION y = by - cdis; y <= by + cdis; y++) {
-                for (POSITION x = bx - cdis; x <= bx + cdis; x++) {
-                    if (!in_bounds(floor_ptr, y, x)) {
+            for (const auto &offset : get_ring_offsets(cdis)) {
+                const auto y = by + offset.y;
+                const auto x = bx + offset.x;
+                if (!in_bounds(floor_ptr, y, x)) {
+                    continue;
+                }
+                if (distance(y1, x1, y, x) != bdis) {
+                    continue;
+                }
+
+                switch (typ) {
+                case AttributeType::LITE:
+                case AttributeType::LITE_WEAK:
+                    /* Lights are stopped by opaque terrains */
+                    if (!los(player_ptr, by, bx, y, x)) {
                         continue;
                     }
-                    if (distance(y1, x1, y, x) != bdis) {
+                    break;
+                case AttributeType::DISINTEGRATE:
+                    /* Disintegration are stopped only by perma-walls */
+                    if (!in_disintegration_range(floor_ptr, by, bx, y, x)) {
                         continue;
                     }
-                    if (distance(by, bx, y, x) != cdis) {
+                    break;
+                default:
+                    /* Ball explosions are stopped by walls */
+                    if (!projectable(player_ptr, by, bx, y, x)) {
                         continue;
                     }
-
-                    switch (typ) {
-                    case AttributeType::LITE:
-                    case AttributeType::LITE_WEAK:
-                        /* Lights are stopped by opaque terrains */
-                        if (!los(player_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    case AttributeType::DISINTEGRATE:
-                        /* Disintegration are stopped only by perma-walls */
-                        if (!in_disintegration_range(floor_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    default:
-                        /* Ball explosions are stopped by walls */
-                        if (!projectable(player_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    }
-
-                    gy[*pgrids] = y;
-                    gx[*pgrids] = x;
-                    (*pgrids)++;
+                    break;
                 }
+
+                gy[*pgrids] = y;
+                gx[*pgrids] = x;
+                (*pgrids)++;
             }
         }
 
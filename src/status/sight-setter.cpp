@@ -22,7 +22,7 @@ static bool update_sight(PlayerType *player_ptr, const bool notice)
     }
 
     static constexpr auto flags = {
-        StatusRecalculatingFlag::BONUS,
+        StatusRecalculatingFlag::BONUS_SENSE,
         StatusRecalculatingFlag::MONSTER_STATUSES,
     };
     rfu.set_flags(flags);
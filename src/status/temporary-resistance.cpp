@@ -49,7 +49,7 @@ bool set_tim_levitation(PlayerType *player_ptr, TIME_EFFECT v, bool do_dec)
         disturb(player_ptr, false, false);
     }
 
-    rfu.set_flag(StatusRecalculatingFlag::BONUS);
+    rfu.set_flag(StatusRecalculatingFlag::BONUS_SENSE);
     handle_stuff(player_ptr);
     return true;
 }
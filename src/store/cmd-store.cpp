@@ -189,7 +189,11 @@ void do_cmd_store(PlayerType *player_ptr)
             }
         }
 
-        if (rfu.has(StatusRecalculatingFlag::BONUS)) {
+        static constexpr auto flags_bonus = {
+            StatusRecalculatingFlag::BONUS,
+            StatusRecalculatingFlag::BONUS_WEIGHT,
+        };
+        if (rfu.has_any_of(flags_bonus)) {
             display_store_inventory(player_ptr, store_num);
         }
 
@@ -20,3 +20,13 @@ dungeon_type &FloorType::get_dungeon_definition() const
 {
     return dungeons_info[this->dungeon_idx];
 }
+
+grid_type &FloorType::get_grid(const Pos2D &pos)
+{
+    return this->grid_array.get_grid(pos);
+}
+
+const grid_type &FloorType::get_grid(const Pos2D &pos) const
+{
+    return this->grid_array.get_grid(pos);
+}
@@ -2,8 +2,13 @@
 
 #include "dungeon/quest.h"
 #include "floor/floor-base-definitions.h"
+#include "floor/found-item-index.h"
+#include "floor/line-of-sight-cache.h"
 #include "monster/monster-timed-effect-types.h"
 #include "system/angband.h"
+#include "system/grid-array.h"
+#include "util/index-bitset.h"
+#include "util/point-2d.h"
 #include <array>
 #include <vector>
 
@@ -34,14 +39,13 @@ constexpr auto VIEW_MAX = 1536;
 constexpr auto REDRAW_MAX = 2298;
 
 struct dungeon_type;
-struct grid_type;
 class MonsterEntity;
 class ItemEntity;
 class FloorType {
 public:
     FloorType() = default;
     short dungeon_idx = 0;
-    std::vector<std::vector<grid_type>> grid_array;
+    GridArray grid_array; /*!< フロアの全マス (行優先の連続領域) */
     DEPTH dun_level = 0; /*!< 現在の実ダンジョン階層 base_level の参照元となる / Current dungeon level */
     DEPTH base_level = 0; /*!< 基本生成レベル、後述のobject_level, monster_levelの参照元となる / Base dungeon level */
     DEPTH object_level = 0; /*!< アイテムの生成レベル、 base_level を起点に一時変更する時に参照 / Current object creation level */
@@ -51,14 +55,19 @@ public:
     MONSTER_NUMBER num_repro = 0; /*!< Current reproducer count */
 
     GAME_TURN generated_turn = 0; /* Turn when level began */
+    uint32_t terrain_generation = 0; /*!< 地形変化世代 (地形を書き換える度に増やす) */
+    LineOfSightCache line_of_sight_cache; /*!< 視線・射線判定結果のキャッシュ */
 
     std::vector<ItemEntity> o_list; /*!< The array of dungeon items [max_o_idx] */
     OBJECT_IDX o_max = 0; /* Number of allocated objects */
     OBJECT_IDX o_cnt = 0; /* Number of live objects */
+    IndexBitset live_object_indices; /*!< o_list のうち使用中のアイテムの添字 */
+    FoundItemIndex found_item_index; /*!< o_list のうち発見済みのアイテムの索引 */
 
     std::vector<MonsterEntity> m_list; /*!< The array of dungeon monsters [max_m_idx] */
     MONSTER_IDX m_max = 0; /* Number of allocated monsters */
     MONSTER_IDX m_cnt = 0; /* Number of live monsters */
+    IndexBitset live_monster_indices; /*!< m_list のうち生存しているモンスターの添字 */
 
     std::vector<int16_t> mproc_list[MAX_MTIMED]{}; /*!< The array to process dungeon monsters[max_m_idx] */
     int16_t mproc_max[MAX_MTIMED]{}; /*!< Number of monsters to be processed */
@@ -87,4 +96,6 @@ public:
     void set_dungeon_index(short dungeon_idx_); /*!< @todo 後でenum class にする */
     void reset_dungeon_index();
     dungeon_type &get_dungeon_definition() const;
+    grid_type &get_grid(const Pos2D &pos);
+    const grid_type &get_grid(const Pos2D &pos) const;
 };
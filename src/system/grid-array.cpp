@@ -0,0 +1,23 @@
+﻿#include "system/grid-array.h"
+
+/*!
+ * @brief 配列の大きさを変更し、全マスを初期状態に戻す
+ * @param height 行数
+ * @param width 列数
+ */
+void GridArray::resize(int height, int width)
+{
+    this->grids.assign(static_cast<size_t>(height) * width, {});
+    this->height = height;
+    this->width = width;
+}
+
+/*!
+ * @brief 全マスを解放する
+ */
+void GridArray::clear()
+{
+    this->grids.clear();
+    this->height = 0;
+    this->width = 0;
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "system/grid-type-definition.h"
+#include "util/point-2d.h"
+#include <vector>
+
+/*!
+ * @brief フロアの全マスを保持する配列
+ * @details 行優先 (row-major) の1本の連続領域に全マスを格納する.
+ * 行ごとに別々のヒープ領域を持つ二重 vector と異なり、隣接行の参照でもポインタを辿らずに済む.
+ * 既存コードとの互換のため grid_array[y][x] の形式でもアクセスできる.
+ */
+class GridArray {
+public:
+    GridArray() = default;
+
+    void resize(int height, int width);
+    void clear();
+
+    /*!
+     * @brief 指定した行の先頭マスへのポインタを返す
+     * @param y 行 (Y座標)
+     * @return 行の先頭マスへのポインタ. 続けて [x] で列を指定する
+     */
+    grid_type *operator[](int y) noexcept
+    {
+        return &this->grids[y * this->width];
+    }
+
+    const grid_type *operator[](int y) const noexcept
+    {
+        return &this->grids[y * this->width];
+    }
+
+    grid_type &get_grid(const Pos2D &pos) noexcept
+    {
+        return this->grids[pos.y * this->width + pos.x];
+    }
+
+    const grid_type &get_grid(const Pos2D &pos) const noexcept
+    {
+        return this->grids[pos.y * this->width + pos.x];
+    }
+
+    int get_height() const noexcept
+    {
+        return this->height;
+    }
+
+    int get_width() const noexcept
+    {
+        return this->width;
+    }
+
+private:
+    std::vector<grid_type> grids;
+    int height = 0;
+    int width = 0;
+};
@@ -48,10 +48,14 @@ class MonsterRaceInfo;
 enum class TerrainCharacteristics;
 struct grid_type {
 public:
+    /*
+     * 視界・光源・フロー計算などの毎ターンの走査で参照される項目を先頭に置く.
+     * アイテムリストは末尾に置き、本体はヒープ側に確保される (ObjectIndexList 参照).
+     */
     BIT_FLAGS info{}; /* Hack -- grid flags */
 
     FEAT_IDX feat{}; /* Hack -- feature type */
-    ObjectIndexList o_idx_list; /* Object list in this grid */
+    FEAT_IDX mimic{}; /* Feature to mimic */
     MONSTER_IDX m_idx{}; /* Monster in this grid */
 
     /*
@@ -61,12 +65,12 @@ public:
      */
     int16_t special{};
 
-    FEAT_IDX mimic{}; /* Feature to mimic */
-
     byte costs[FLOW_MAX]{}; /* Hack -- cost of flowing */
     byte dists[FLOW_MAX]{}; /* Hack -- distance from player */
     byte when{}; /* Hack -- when cost was computed */
 
+    ObjectIndexList o_idx_list; /* Object list in this grid */
+
     bool is_floor() const;
     bool is_room() const;
     bool is_extra() const;
@@ -16,6 +16,7 @@
 #include "system/system-variables.h"
 #include "util/flag-group.h"
 #include <optional>
+#include <string>
 
 enum class FixedArtifactId : short;
 enum class ItemKindType : short;
@@ -25,6 +26,31 @@ enum class RandomArtActType : short;
 class ArtifactType;
 class EgoItemDefinition;
 class BaseitemInfo;
+
+/*!
+ * @brief アイテム名称のキャッシュ
+ * @details 複製したアイテムにはキャッシュを引き継がない.
+ * 世代番号が0なら無効.
+ */
+class ItemDescriptionCache {
+public:
+    ItemDescriptionCache() = default;
+    ItemDescriptionCache(const ItemDescriptionCache &)
+    {
+    }
+
+    ItemDescriptionCache &operator=(const ItemDescriptionCache &)
+    {
+        this->generation = 0;
+        return *this;
+    }
+
+    uint32_t generation = 0; //!< 名称を作成した時の世代番号
+    BIT_FLAGS mode = 0; //!< 名称を作成した時の表記オプション
+    size_t max_length = 0; //!< 名称を作成した時の最大長
+    std::string name{}; //!< 名称
+};
+
 class ItemEntity {
 public:
     ItemEntity();
@@ -70,6 +96,7 @@ public:
     EnumClassFlagGroup<CurseTraitType> curse_flags{}; /*!< Flags for curse */
     MONSTER_IDX held_m_idx{}; /*!< アイテムを所持しているモンスターID (いないなら 0) / Monster holding us (if any) */
     int artifact_bias{}; /*!< ランダムアーティファクト生成時のバイアスID */
+    mutable ItemDescriptionCache description_cache{}; /*!< describe_flavor() の結果のキャッシュ */
 
     void wipe();
     void copy_from(const ItemEntity *j_ptr);
@@ -52,6 +52,9 @@ enum class SubWindowRedrawingFlag {
 
 enum class StatusRecalculatingFlag {
     BONUS, /*!< 能力値修正 */
+    BONUS_RIDING, /*!< 能力値修正 (乗馬の状態の変化に伴う分のみ) */
+    BONUS_WEIGHT, /*!< 能力値修正 (所持品の重量の変化に伴う分のみ) */
+    BONUS_SENSE, /*!< 能力値修正 (感知系の一時効果の変化に伴う分のみ) */
     TORCH, /*!< 光源半径 */
     HP,
     MP,
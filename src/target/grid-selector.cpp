@@ -12,6 +12,7 @@
 #include "io/screen-util.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
+#include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
 #include "target/target-checker.h"
 #include "term/screen-processor.h"
@@ -81,7 +82,7 @@ static void tgt_pt_prepare(PlayerType *player_ptr, std::vector<POSITION> &ys, st
         }
     }
 
-    ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+    sort_positions_by_distance(player_ptr, ys, xs);
 }
 
 /*!
@@ -106,7 +107,7 @@ std::unordered_map<int, std::function<bool(grid_type *)>> tgt_pt_symbol_call_bac
 /*!
  * @brief 位置ターゲット指定情報構造体
  * @details
- * ang_sort() を利用する関係上、y/x 座標それぞれについて配列を作る。
+ * y/x 座標それぞれについて配列を作る。
  */
 struct tgt_pt_info {
     tgt_pt_info()
@@ -2,6 +2,7 @@
 #include "effect/effect-characteristics.h"
 #include "effect/spells-effect-util.h"
 #include "floor/cave.h"
+#include "floor/line-of-sight-cache.h"
 #include "grid/feature-flag-types.h"
 #include "spell-class/spells-mirror-master.h"
 #include "system/floor-type-definition.h"
@@ -10,7 +11,8 @@
 #include "util/bit-flags-calculator.h"
 
 struct projection_path_type {
-    std::vector<std::pair<int, int>> *position;
+    std::pair<int, int> *position;
+    int *length;
     POSITION range;
     BIT_FLAGS flag;
     POSITION y1;
@@ -30,14 +32,14 @@ struct projection_path_type {
     int k;
 };
 
-std::vector<std::pair<int, int>>::const_iterator projection_path::begin() const
+projection_path::const_iterator projection_path::begin() const
 {
     return this->position.cbegin();
 }
 
-std::vector<std::pair<int, int>>::const_iterator projection_path::end() const
+projection_path::const_iterator projection_path::end() const
 {
-    return this->position.cend();
+    return this->position.cbegin() + this->length;
 }
 
 const std::pair<int, int> &projection_path::front() const
@@ -47,7 +49,7 @@ const std::pair<int, int> &projection_path::front() const
 
 const std::pair<int, int> &projection_path::back() const
 {
-    return this->position.back();
+    return this->position[this->length - 1];
 }
 
 const std::pair<int, int> &projection_path::operator[](int num) const
@@ -57,13 +59,14 @@ const std::pair<int, int> &projection_path::operator[](int num) const
 
 int projection_path::path_num() const
 {
-    return static_cast<int>(this->position.size());
+    return this->length;
 }
 
 static projection_path_type *initialize_projection_path_type(
-    projection_path_type *pp_ptr, std::vector<std::pair<int, int>> *position, POSITION range, BIT_FLAGS flag, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+    projection_path_type *pp_ptr, std::pair<int, int> *position, int *length, POSITION range, BIT_FLAGS flag, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
     pp_ptr->position = position;
+    pp_ptr->length = length;
     pp_ptr->range = range;
     pp_ptr->flag = flag;
     pp_ptr->y1 = y1;
@@ -101,26 +104,26 @@ static bool project_stop(PlayerType *player_ptr, projection_path_type *pp_ptr)
     }
 
     if (any_bits(pp_ptr->flag, PROJECT_DISI)) {
-        if (!pp_ptr->position->empty() && cave_stop_disintegration(floor_ptr, pp_ptr->y, pp_ptr->x)) {
+        if ((*pp_ptr->length > 0) && cave_stop_disintegration(floor_ptr, pp_ptr->y, pp_ptr->x)) {
             return true;
         }
     } else if (any_bits(pp_ptr->flag, PROJECT_LOS)) {
-        if (!pp_ptr->position->empty() && !cave_los_bold(floor_ptr, pp_ptr->y, pp_ptr->x)) {
+        if ((*pp_ptr->length > 0) && !cave_los_bold(floor_ptr, pp_ptr->y, pp_ptr->x)) {
             return true;
         }
     } else if (none_bits(pp_ptr->flag, PROJECT_PATH)) {
-        if (!pp_ptr->position->empty() && !cave_has_flag_bold(floor_ptr, pp_ptr->y, pp_ptr->x, TerrainCharacteristics::PROJECT)) {
+        if ((*pp_ptr->length > 0) && !cave_has_flag_bold(floor_ptr, pp_ptr->y, pp_ptr->x, TerrainCharacteristics::PROJECT)) {
             return true;
         }
     }
 
     if (any_bits(pp_ptr->flag, PROJECT_MIRROR)) {
-        if (!pp_ptr->position->empty() && floor_ptr->grid_array[pp_ptr->y][pp_ptr->x].is_mirror()) {
+        if ((*pp_ptr->length > 0) && floor_ptr->grid_array[pp_ptr->y][pp_ptr->x].is_mirror()) {
             return true;
         }
     }
 
-    if (any_bits(pp_ptr->flag, PROJECT_STOP) && !pp_ptr->position->empty() && (player_bold(player_ptr, pp_ptr->y, pp_ptr->x) || floor_ptr->grid_array[pp_ptr->y][pp_ptr->x].m_idx != 0)) {
+    if (any_bits(pp_ptr->flag, PROJECT_STOP) && (*pp_ptr->length > 0) && (player_bold(player_ptr, pp_ptr->y, pp_ptr->x) || floor_ptr->grid_array[pp_ptr->y][pp_ptr->x].m_idx != 0)) {
         return true;
     }
 
@@ -131,6 +134,17 @@ static bool project_stop(PlayerType *player_ptr, projection_path_type *pp_ptr)
     return false;
 }
 
+/*!
+ * @brief 現在の座標を経路に加える
+ * @param pp_ptr 経路計算の作業領域
+ * @return 経路が最大長に達したらfalse
+ */
+static bool add_position(projection_path_type *pp_ptr)
+{
+    pp_ptr->position[(*pp_ptr->length)++] = { pp_ptr->y, pp_ptr->x };
+    return *pp_ptr->length < MAX_PROJECTION_PATH_LENGTH;
+}
+
 static void calc_frac(projection_path_type *pp_ptr, bool is_vertical)
 {
     if (pp_ptr->m == 0) {
@@ -155,8 +169,7 @@ static void calc_frac(projection_path_type *pp_ptr, bool is_vertical)
 static void calc_projection_to_target(PlayerType *player_ptr, projection_path_type *pp_ptr, bool is_vertical)
 {
     while (true) {
-        pp_ptr->position->emplace_back(pp_ptr->y, pp_ptr->x);
-        if (static_cast<int>(pp_ptr->position->size()) + pp_ptr->k / 2 >= pp_ptr->range) {
+        if (!add_position(pp_ptr) || (*pp_ptr->length + pp_ptr->k / 2 >= pp_ptr->range)) {
             break;
         }
 
@@ -216,8 +229,7 @@ static bool calc_horizontal_projection(PlayerType *player_ptr, projection_path_t
 static void calc_projection_others(PlayerType *player_ptr, projection_path_type *pp_ptr)
 {
     while (true) {
-        pp_ptr->position->emplace_back(pp_ptr->y, pp_ptr->x);
-        if (static_cast<int>(pp_ptr->position->size()) * 3 / 2 >= pp_ptr->range) {
+        if (!add_position(pp_ptr) || (*pp_ptr->length * 3 / 2 >= pp_ptr->range)) {
             break;
         }
 
@@ -244,13 +256,12 @@ static void calc_projection_others(PlayerType *player_ptr, projection_path_type
  */
 projection_path::projection_path(PlayerType *player_ptr, POSITION range, POSITION y1, POSITION x1, POSITION y2, POSITION x2, BIT_FLAGS flag)
 {
-    this->position.clear();
     if ((x1 == x2) && (y1 == y2)) {
         return;
     }
 
     projection_path_type tmp_projection_path;
-    auto *pp_ptr = initialize_projection_path_type(&tmp_projection_path, &this->position, range, flag, y1, x1, y2, x2);
+    auto *pp_ptr = initialize_projection_path_type(&tmp_projection_path, this->position.data(), &this->length, range, flag, y1, x1, y2, x2);
     set_asxy(pp_ptr);
     pp_ptr->half = pp_ptr->ay * pp_ptr->ax;
     pp_ptr->full = pp_ptr->half << 1;
@@ -269,15 +280,19 @@ projection_path::projection_path(PlayerType *player_ptr, POSITION range, POSITIO
     calc_projection_others(player_ptr, pp_ptr);
 }
 
-/*
- * Determine if a bolt spell cast from (y1,x1) to (y2,x2) will arrive
- * at the final destination, assuming no monster gets in the way.
- *
- * This is slightly (but significantly) different from "los(y1,x1,y2,x2)".
+/*!
+ * @brief 射程内で始点から終点まで射線が通るかを判定する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param range 射程
+ * @param y1 始点のy座標
+ * @param x1 始点のx座標
+ * @param y2 終点のy座標
+ * @param x2 終点のx座標
+ * @return 射線が通るならtrue
  */
-bool projectable(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+static bool calc_projectable(PlayerType *player_ptr, POSITION range, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
-    projection_path grid_g(player_ptr, (project_length ? project_length : get_max_range(player_ptr)), y1, x1, y2, x2, 0);
+    projection_path grid_g(player_ptr, range, y1, x1, y2, x2, 0);
     if (grid_g.path_num() == 0) {
         return true;
     }
@@ -290,6 +305,27 @@ bool projectable(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2,
     return true;
 }
 
+/*
+ * Determine if a bolt spell cast from (y1,x1) to (y2,x2) will arrive
+ * at the final destination, assuming no monster gets in the way.
+ *
+ * This is slightly (but significantly) different from "los(y1,x1,y2,x2)".
+ * The result depends only on the terrain, so it is cached per floor until the terrain changes.
+ */
+bool projectable(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    const auto range = project_length ? project_length : get_max_range(player_ptr);
+    auto &floor = *player_ptr->current_floor_ptr;
+    auto &cache = floor.line_of_sight_cache;
+    if (const auto cached = cache.find(floor.terrain_generation, LineOfSightType::PROJECTABLE, y1, x1, y2, x2, range)) {
+        return *cached;
+    }
+
+    const auto result = calc_projectable(player_ptr, range, y1, x1, y2, x2);
+    cache.store(LineOfSightType::PROJECTABLE, y1, x1, y2, x2, range, result);
+    return result;
+}
+
 /*!
  * @briefプレイヤーの攻撃射程(マス) / Maximum range (spells, etc)
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -1,13 +1,20 @@
 ﻿#pragma once
 
+#include "floor/floor-base-definitions.h"
 #include "system/angband.h"
+#include <array>
 #include <utility>
-#include <vector>
+
+/*!
+ * @brief 投射経路の最大長
+ * @details 経路はフロアの端で必ず止まるため、フロアの最大幅を超えることはない.
+ */
+constexpr auto MAX_PROJECTION_PATH_LENGTH = MAX_WID;
 
 class PlayerType;
 class projection_path {
 public:
-    using const_iterator = std::vector<std::pair<int, int>>::const_iterator;
+    using const_iterator = std::array<std::pair<int, int>, MAX_PROJECTION_PATH_LENGTH>::const_iterator;
 
     projection_path(PlayerType *player_ptr, POSITION range, POSITION y1, POSITION x1, POSITION y2, POSITION x2, BIT_FLAGS flag);
     const_iterator begin() const;
@@ -18,7 +25,8 @@ public:
     int path_num() const;
 
 private:
-    std::vector<std::pair<int, int>> position;
+    std::array<std::pair<int, int>, MAX_PROJECTION_PATH_LENGTH> position; //!< 経路上の座標 (ヒープ確保を避けるため固定長)
+    int length = 0; //!< 経路の長さ
 };
 bool projectable(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2);
 int get_max_range(PlayerType *player_ptr);
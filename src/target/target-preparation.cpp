@@ -164,9 +164,9 @@ void target_set_prepare(PlayerType *player_ptr, std::vector<POSITION> &ys, std::
     }
 
     if (mode & (TARGET_KILL)) {
-        ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+        sort_positions_by_distance(player_ptr, ys, xs);
     } else {
-        ang_sort(player_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_importance, ang_sort_swap_position);
+        sort_positions_by_importance(player_ptr, ys, xs);
     }
 
     // 乗っているモンスターがターゲットリストの先頭にならないようにする調整。
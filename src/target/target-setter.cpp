@@ -29,7 +29,7 @@
 #include <vector>
 
 // "interesting" な座標たちを記録する配列。
-// ang_sort() を利用する関係上、y/x座標それぞれについて配列を作る。
+// y/x座標それぞれについて配列を作る。
 static std::vector<POSITION> ys_interest;
 static std::vector<POSITION> xs_interest;
 
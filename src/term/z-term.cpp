@@ -14,6 +14,12 @@
 #include "term/gameterm.h"
 #include "term/term-color-types.h"
 #include "term/z-virt.h"
+#include <bit>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define TERM_DIFF_SSE2
+#endif
 
 /* Special flags in the attr data */
 #define AF_BIGTILE2 0xf0
@@ -114,10 +120,10 @@ TermCenteredOffsetSetter::~TermCenteredOffsetSetter()
  * Initialize a "term_win" (using the given window size)
  */
 term_win::term_win(TERM_LEN w, TERM_LEN h)
-    : a(h, std::vector<TERM_COLOR>(w))
-    , c(h, std::vector<char>(w))
-    , ta(h, std::vector<TERM_COLOR>(w))
-    , tc(h, std::vector<char>(w))
+    : a(w, h)
+    , c(w, h)
+    , ta(w, h)
+    , tc(w, h)
 {
 }
 
@@ -141,21 +147,14 @@ std::unique_ptr<term_win> term_win::clone() const
 void term_win::resize(TERM_LEN w, TERM_LEN h)
 {
     /* Ignore non-changes */
-    if (this->a.size() == static_cast<size_t>(h) && this->a[0].size() == static_cast<size_t>(w)) {
+    if ((this->a.height() == h) && (this->a.width() == w)) {
         return;
     }
 
-    this->a.resize(h, std::vector<TERM_COLOR>(w));
-    this->c.resize(h, std::vector<char>(w));
-    this->ta.resize(h, std::vector<TERM_COLOR>(w));
-    this->tc.resize(h, std::vector<char>(w));
-
-    for (TERM_LEN y = 0; y < h; y++) {
-        this->a[y].resize(w);
-        this->c[y].resize(w);
-        this->ta[y].resize(w);
-        this->tc[y].resize(w);
-    }
+    this->a.resize(w, h);
+    this->c.resize(w, h);
+    this->ta.resize(w, h);
+    this->tc.resize(w, h);
 
     /* Illegal cursor */
     if (this->cx >= w) {
@@ -265,12 +264,25 @@ static errr term_pict_hack(TERM_LEN x, TERM_LEN y, int n, const TERM_COLOR *ap,
 
 /*** Efficient routines ***/
 
+/*
+ * Let the game draw its delayed updates before the screen is touched,
+ * so that they are not drawn over later changes.
+ */
+static void term_draw_delayed(void)
+{
+    if (game_term->delayed_draw_hook) {
+        game_term->delayed_draw_hook();
+    }
+}
+
 /*
  * Mentally draw an attr/char at a given location
  * Assumes given location and values are valid.
  */
 static void term_queue_char_aux(TERM_LEN x, TERM_LEN y, TERM_COLOR a, char c, TERM_COLOR ta, char tc)
 {
+    term_draw_delayed();
+
     if ((x < 0) || (x >= game_term->wid)) {
         return;
     }
@@ -413,6 +425,8 @@ void term_queue_bigchar(TERM_LEN x, TERM_LEN y, TERM_COLOR a, char c, TERM_COLOR
  */
 void term_queue_line(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR *a, char *c, TERM_COLOR *ta, char *tc)
 {
+    term_draw_delayed();
+
     const auto &scrn = game_term->scr;
 
     TERM_LEN x1 = -1;
@@ -488,19 +502,21 @@ void term_queue_line(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR *a, char *c, TERM
  */
 static void term_queue_chars(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, std::string_view sv)
 {
+    term_draw_delayed();
+
     TERM_LEN x1 = -1, x2 = -1;
 
-    auto &scr_aa = game_term->scr->a[y];
+    auto *scr_aa = game_term->scr->a[y];
 #ifdef JP
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 #else
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 #endif
 
 #ifdef JP
@@ -618,23 +634,126 @@ static void term_queue_chars(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, std::s
 
 /*** Refresh routines ***/
 
+/*!
+ * @brief 画面イメージ1行分の各面への参照
+ */
+struct TermRowCells {
+    TermRowCells(const term_win &win, TERM_LEN y)
+        : aa(win.a[y])
+        , cc(win.c[y])
+        , taa(win.ta[y])
+        , tcc(win.tc[y])
+    {
+    }
+
+    const TERM_COLOR *aa;
+    const char *cc;
+    const TERM_COLOR *taa;
+    const char *tcc;
+
+    bool is_same(const TermRowCells &other, TERM_LEN x) const
+    {
+        return (this->aa[x] == other.aa[x]) && (this->cc[x] == other.cc[x]) && (this->taa[x] == other.taa[x]) && (this->tcc[x] == other.tcc[x]);
+    }
+
+#ifdef TERM_DIFF_SSE2
+    static constexpr TERM_LEN BLOCK_LEN = 16;
+
+    /*!
+     * @brief x桁目からの16桁を比較する
+     * @return 食い違う桁のビットを立てたマスク (最下位ビットがx桁目)
+     */
+    uint32_t diff_block(const TermRowCells &other, TERM_LEN x) const
+    {
+        const auto compare = [x](const auto *lhs, const auto *rhs) {
+            const auto l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + x));
+            const auto r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + x));
+            return _mm_cmpeq_epi8(l, r);
+        };
+
+        auto same = _mm_and_si128(compare(this->aa, other.aa), compare(this->cc, other.cc));
+        same = _mm_and_si128(same, compare(this->taa, other.taa));
+        same = _mm_and_si128(same, compare(this->tcc, other.tcc));
+        return static_cast<uint32_t>(_mm_movemask_epi8(same)) ^ 0xffffU;
+    }
+#endif
+};
+
+/*!
+ * @brief 行の指定範囲のうち、表示済の内容と画面イメージが食い違う範囲を求める
+ * @param y 行
+ * @param x1 範囲の左端
+ * @param x2 範囲の右端
+ * @return 食い違う最初と最後の桁. 食い違いがなければnullopt
+ * @details SSE2が使える環境では16桁ずつまとめて比較する.
+ */
+static std::optional<std::pair<TERM_LEN, TERM_LEN>> find_row_difference(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
+{
+    const TermRowCells old_row(*game_term->old, y);
+    const TermRowCells scr_row(*game_term->scr, y);
+
+    auto first = x1;
+#ifdef TERM_DIFF_SSE2
+    for (; first + TermRowCells::BLOCK_LEN - 1 <= x2; first += TermRowCells::BLOCK_LEN) {
+        if (const auto mask = old_row.diff_block(scr_row, first); mask != 0) {
+            first += std::countr_zero(mask);
+            break;
+        }
+    }
+#endif
+    while ((first <= x2) && old_row.is_same(scr_row, first)) {
+        first++;
+    }
+
+    if (first > x2) {
+        return std::nullopt;
+    }
+
+    auto last = x2;
+#ifdef TERM_DIFF_SSE2
+    for (; last - TermRowCells::BLOCK_LEN + 1 >= first; last -= TermRowCells::BLOCK_LEN) {
+        if (const auto mask = old_row.diff_block(scr_row, last - TermRowCells::BLOCK_LEN + 1); mask != 0) {
+            last -= std::countl_zero(mask) - (32 - TermRowCells::BLOCK_LEN);
+            break;
+        }
+    }
+#endif
+    while (old_row.is_same(scr_row, last)) {
+        last--;
+    }
+
+#ifdef JP
+    /* 全角文字の途中から描画しないよう、範囲の左端から文字単位で数えて揃える */
+    auto start = x1;
+    for (auto x = x1; x <= first; x += (iskanji(scr_row.cc[x]) && !(scr_row.aa[x] & AF_TILE1)) ? 2 : 1) {
+        start = x;
+    }
+
+    first = start;
+
+    /* 全角文字の1バイト目で終わる時は2バイト目まで含める */
+    last = std::min(last + 1, x2);
+#endif
+    return std::make_pair(first, last);
+}
+
 /*
  * Flush a row of the current window (see "term_fresh")
  * Display text using "term_pict()"
  */
 static void term_fresh_row_pict(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
-    auto &old_taa = game_term->old->ta[y];
-    auto &old_tcc = game_term->old->tc[y];
+    auto *old_taa = game_term->old->ta[y];
+    auto *old_tcc = game_term->old->tc[y];
 
-    const auto &scr_taa = game_term->scr->ta[y];
-    const auto &scr_tcc = game_term->scr->tc[y];
+    const auto *scr_taa = game_term->scr->ta[y];
+    const auto *scr_tcc = game_term->scr->tc[y];
 
     TERM_COLOR ota;
     char otc;
@@ -744,16 +863,16 @@ static void term_fresh_row_pict(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
  */
 static void term_fresh_row_both(TERM_LEN y, int x1, int x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
-    auto &old_taa = game_term->old->ta[y];
-    auto &old_tcc = game_term->old->tc[y];
-    const auto &scr_taa = game_term->scr->ta[y];
-    const auto &scr_tcc = game_term->scr->tc[y];
+    auto *old_taa = game_term->old->ta[y];
+    auto *old_tcc = game_term->old->tc[y];
+    const auto *scr_taa = game_term->scr->ta[y];
+    const auto *scr_tcc = game_term->scr->tc[y];
 
     TERM_COLOR ota;
     char otc;
@@ -945,11 +1064,11 @@ static void term_fresh_row_both(TERM_LEN y, int x1, int x2)
  */
 static void term_fresh_row_text(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
 {
-    auto &old_aa = game_term->old->a[y];
-    auto &old_cc = game_term->old->c[y];
+    auto *old_aa = game_term->old->a[y];
+    auto *old_cc = game_term->old->c[y];
 
-    const auto &scr_aa = game_term->scr->a[y];
-    const auto &scr_cc = game_term->scr->c[y];
+    const auto *scr_aa = game_term->scr->a[y];
+    const auto *scr_cc = game_term->scr->c[y];
 
     /* The "always_text" flag */
     int always_text = game_term->always_text;
@@ -1105,6 +1224,8 @@ static void term_fresh_row_text(TERM_LEN y, TERM_LEN x1, TERM_LEN x2)
  */
 errr term_fresh(void)
 {
+    term_draw_delayed();
+
     int w = game_term->wid;
     int h = game_term->hgt;
 
@@ -1148,11 +1269,11 @@ errr term_fresh(void)
 
         /* Wipe each row */
         for (TERM_LEN y = 0; y < h; y++) {
-            auto &aa = old->a[y];
-            auto &cc = old->c[y];
+            auto *aa = old->a[y];
+            auto *cc = old->c[y];
 
-            auto &taa = old->ta[y];
-            auto &tcc = old->tc[y];
+            auto *taa = old->ta[y];
+            auto *tcc = old->tc[y];
 
             /* Wipe each column */
             for (TERM_LEN x = 0; x < w; x++) {
@@ -1187,11 +1308,11 @@ errr term_fresh(void)
             TERM_LEN tx = old->cx;
             TERM_LEN ty = old->cy;
 
-            const auto &old_aa = old->a[ty];
-            const auto &old_cc = old->c[ty];
+            const auto *old_aa = old->a[ty];
+            const auto *old_cc = old->c[ty];
 
-            const auto &old_taa = old->ta[ty];
-            const auto &old_tcc = old->tc[ty];
+            const auto *old_taa = old->ta[ty];
+            const auto *old_tcc = old->tc[ty];
 
             TERM_COLOR ota = old_taa[tx];
             char otc = old_tcc[tx];
@@ -1256,6 +1377,16 @@ errr term_fresh(void)
 
             /* Flush each "modified" row */
             if (x1 <= x2) {
+                /* Skip the columns which are already displayed */
+                const auto difference = find_row_difference(y, x1, x2);
+                if (!difference) {
+                    game_term->x1[y] = w;
+                    game_term->x2[y] = 0;
+                    continue;
+                }
+
+                std::tie(x1, x2) = *difference;
+
                 /* Always use "term_pict()" */
                 if (game_term->always_pict) {
                     /* Flush the row */
@@ -1606,6 +1737,8 @@ errr term_putstr(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, std::string_view s
  */
 errr term_erase(TERM_LEN x, TERM_LEN y, int n)
 {
+    term_draw_delayed();
+
     TERM_LEN w = game_term->wid;
     /* int h = Term->hgt; */
 
@@ -1629,11 +1762,11 @@ errr term_erase(TERM_LEN x, TERM_LEN y, int n)
     }
 
     /* Fast access */
-    auto &scr_aa = game_term->scr->a[y];
-    auto &scr_cc = game_term->scr->c[y];
+    auto *scr_aa = game_term->scr->a[y];
+    auto *scr_cc = game_term->scr->c[y];
 
-    auto &scr_taa = game_term->scr->ta[y];
-    auto &scr_tcc = game_term->scr->tc[y];
+    auto *scr_taa = game_term->scr->ta[y];
+    auto *scr_tcc = game_term->scr->tc[y];
 
 #ifdef JP
     /*
@@ -1716,6 +1849,8 @@ errr term_erase(TERM_LEN x, TERM_LEN y, int n)
  */
 errr term_clear(void)
 {
+    term_draw_delayed();
+
     TERM_LEN w = game_term->wid;
     TERM_LEN h = game_term->hgt;
 
@@ -1730,11 +1865,11 @@ errr term_clear(void)
 
     /* Wipe each row */
     for (TERM_LEN y = 0; y < h; y++) {
-        auto &scr_aa = game_term->scr->a[y];
-        auto &scr_cc = game_term->scr->c[y];
+        auto *scr_aa = game_term->scr->a[y];
+        auto *scr_cc = game_term->scr->c[y];
 
-        auto &scr_taa = game_term->scr->ta[y];
-        auto &scr_tcc = game_term->scr->tc[y];
+        auto *scr_taa = game_term->scr->ta[y];
+        auto *scr_tcc = game_term->scr->tc[y];
 
         /* Wipe each column */
         for (TERM_LEN x = 0; x < w; x++) {
@@ -1814,7 +1949,7 @@ errr term_redraw_section(TERM_LEN x1, TERM_LEN y1, TERM_LEN x2, TERM_LEN y2)
         game_term->x1[i] = x1j;
         game_term->x2[i] = x2j;
 
-        auto &g_ptr = game_term->old->c[i];
+        auto *g_ptr = game_term->old->c[i];
 
         /* Clear the section so it is redrawn */
         for (int j = x1j; j <= x2j; j++) {
@@ -1825,7 +1960,7 @@ errr term_redraw_section(TERM_LEN x1, TERM_LEN y1, TERM_LEN x2, TERM_LEN y2)
         game_term->x1[i] = x1;
         game_term->x2[i] = x2;
 
-        auto &g_ptr = game_term->old->c[i];
+        auto *g_ptr = game_term->old->c[i];
 
         /* Clear the section so it is redrawn */
         for (int j = x1; j <= x2; j++) {
@@ -1885,6 +2020,8 @@ errr term_locate(TERM_LEN *x, TERM_LEN *y)
  */
 errr term_what(TERM_LEN x, TERM_LEN y, TERM_COLOR *a, char *c)
 {
+    term_draw_delayed();
+
     TERM_LEN w = game_term->wid;
     TERM_LEN h = game_term->hgt;
 
@@ -2008,6 +2145,8 @@ errr term_inkey(char *ch, bool wait, bool take)
  */
 errr term_save(void)
 {
+    term_draw_delayed();
+
     /* Push stack */
     game_term->mem_stack.push(game_term->scr->clone());
 
@@ -2021,6 +2160,8 @@ errr term_save(void)
  */
 errr term_load(bool load_all)
 {
+    term_draw_delayed();
+
     TERM_LEN w = game_term->wid;
     TERM_LEN h = game_term->hgt;
 
@@ -2060,6 +2201,8 @@ errr term_load(bool load_all)
  */
 errr term_exchange(void)
 {
+    term_draw_delayed();
+
     TERM_LEN w = game_term->wid;
     TERM_LEN h = game_term->hgt;
 
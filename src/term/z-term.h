@@ -10,12 +10,73 @@
 
 #include "system/angband.h"
 #include "system/h-basic.h"
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stack>
 #include <string_view>
 #include <vector>
 
+/*!
+ * @brief 画面イメージのうち属性または文字の一方を保持する領域
+ * @details 全行を1つの連続した領域に並べて持ち、[y][x] で各セルを参照する.
+ * 行毎の差分を連続したメモリの比較で調べられるようにするため.
+ */
+template <typename T>
+class TermPlane {
+public:
+    TermPlane(TERM_LEN w, TERM_LEN h)
+        : wid(w)
+        , hgt(h)
+        , cells(static_cast<size_t>(w) * h)
+    {
+    }
+
+    T *operator[](TERM_LEN y)
+    {
+        return &this->cells[static_cast<size_t>(y) * this->wid];
+    }
+
+    const T *operator[](TERM_LEN y) const
+    {
+        return &this->cells[static_cast<size_t>(y) * this->wid];
+    }
+
+    TERM_LEN width() const
+    {
+        return this->wid;
+    }
+
+    TERM_LEN height() const
+    {
+        return this->hgt;
+    }
+
+    /*!
+     * @brief 大きさを変更する. 変更前と重なる部分の内容は保持する
+     * @param w 新しい幅
+     * @param h 新しい高さ
+     */
+    void resize(TERM_LEN w, TERM_LEN h)
+    {
+        std::vector<T> resized(static_cast<size_t>(w) * h);
+        const auto copy_wid = std::min(w, this->wid);
+        const auto copy_hgt = std::min(h, this->hgt);
+        for (TERM_LEN y = 0; y < copy_hgt; y++) {
+            std::copy_n((*this)[y], copy_wid, &resized[static_cast<size_t>(y) * w]);
+        }
+
+        this->wid = w;
+        this->hgt = h;
+        this->cells = std::move(resized);
+    }
+
+private:
+    TERM_LEN wid;
+    TERM_LEN hgt;
+    std::vector<T> cells;
+};
+
 /*!
  * @brief A term_win is a "window" for a Term
  */
@@ -28,11 +89,11 @@ public:
     bool cu{}, cv{}; //!< Cursor Useless / Visible codes
     TERM_LEN cx{}, cy{}; //!< Cursor Location (see "Useless")
 
-    std::vector<std::vector<TERM_COLOR>> a; //!< Array[h*w] -- Attribute array
-    std::vector<std::vector<char>> c; //!< Array[h*w] -- Character array
+    TermPlane<TERM_COLOR> a; //!< Array[h*w] -- Attribute array
+    TermPlane<char> c; //!< Array[h*w] -- Character array
 
-    std::vector<std::vector<TERM_COLOR>> ta; //!< Note that the attr pair at(x, y) is a[y][x]
-    std::vector<std::vector<char>> tc; //!< Note that the char pair at(x, y) is c[y][x]
+    TermPlane<TERM_COLOR> ta; //!< Note that the attr pair at(x, y) is a[y][x]
+    TermPlane<char> tc; //!< Note that the char pair at(x, y) is c[y][x]
 
 private:
     term_win(TERM_LEN w, TERM_LEN h);
@@ -102,6 +163,7 @@ struct term_type {
     errr (*wipe_hook)(TERM_LEN x, TERM_LEN y, int n){}; //!< 指定座標テキスト消去実装部 / Hook for drawing some blank spaces
     errr (*text_hook)(TERM_LEN x, TERM_LEN y, int n, TERM_COLOR a, concptr s){}; //!< テキスト描画実装部 / Hook for drawing a string of chars using an attr
     void (*resize_hook)(void){}; //!< 画面リサイズ実装部
+    void (*delayed_draw_hook)(void){}; //!< 保留中の描画実装部 / Hook for drawing delayed updates before the screen is used
     errr (*pict_hook)(TERM_LEN x, TERM_LEN y, int n, const TERM_COLOR *ap, concptr cp, const TERM_COLOR *tap,
         concptr tcp){}; //!< タイル描画実装部 / Hook for drawing a sequence of special attr / char pairs
 
@@ -0,0 +1,89 @@
+﻿#include "util/index-bitset.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+constexpr auto BITS_PER_WORD = 64;
+}
+
+/*!
+ * @brief 記録できる添字の数を変更し、全ての添字を未使用にする
+ * @param size 添字の数
+ */
+void IndexBitset::resize(int size)
+{
+    this->words.assign((size + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+}
+
+/*!
+ * @brief 全ての添字を未使用にする
+ */
+void IndexBitset::clear()
+{
+    std::fill(this->words.begin(), this->words.end(), 0);
+}
+
+void IndexBitset::set(int idx)
+{
+    this->words[idx / BITS_PER_WORD] |= 1ULL << (idx % BITS_PER_WORD);
+}
+
+void IndexBitset::reset(int idx)
+{
+    this->words[idx / BITS_PER_WORD] &= ~(1ULL << (idx % BITS_PER_WORD));
+}
+
+bool IndexBitset::test(int idx) const
+{
+    return (this->words[idx / BITS_PER_WORD] >> (idx % BITS_PER_WORD)) & 1;
+}
+
+/*!
+ * @brief 指定した添字以下で使用中の添字のうち最大のものを返す
+ * @param idx 探索を始める添字
+ * @return 使用中の添字. 存在しなければ -1
+ */
+int IndexBitset::find_prev(int idx) const
+{
+    if (idx < 0) {
+        return -1;
+    }
+
+    auto word_idx = idx / BITS_PER_WORD;
+    const auto shift = BITS_PER_WORD - 1 - (idx % BITS_PER_WORD);
+    auto word = (this->words[word_idx] << shift) >> shift;
+    while (word == 0) {
+        if (word_idx == 0) {
+            return -1;
+        }
+
+        word = this->words[--word_idx];
+    }
+
+    return word_idx * BITS_PER_WORD + (BITS_PER_WORD - 1 - std::countl_zero(word));
+}
+
+/*!
+ * @brief 指定した添字以上で未使用の添字のうち最小のものを返す
+ * @param idx 探索を始める添字
+ * @return 未使用の添字. 存在しなければ resize() で指定した数以上の値
+ */
+int IndexBitset::find_next_unset(int idx) const
+{
+    const auto size = static_cast<int>(this->words.size());
+    auto word_idx = idx / BITS_PER_WORD;
+    if (word_idx >= size) {
+        return size * BITS_PER_WORD;
+    }
+
+    auto word = ~this->words[word_idx] & (~0ULL << (idx % BITS_PER_WORD));
+    while (word == 0) {
+        if (++word_idx == size) {
+            return size * BITS_PER_WORD;
+        }
+
+        word = ~this->words[word_idx];
+    }
+
+    return word_idx * BITS_PER_WORD + std::countr_zero(word);
+}
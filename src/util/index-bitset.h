@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/*!
+ * @brief 配列の添字の使用状況を1ビットずつ記録する集合
+ * @details モンスター配列などで有効な要素の添字を記録し、
+ * 無効な要素を64個単位で読み飛ばしながら有効な要素だけを辿るために用いる.
+ * また、空き要素を先頭から探す際にも使用中の要素を64個単位で読み飛ばせる.
+ */
+class IndexBitset {
+public:
+    IndexBitset() = default;
+
+    void resize(int size);
+    void clear();
+    void set(int idx);
+    void reset(int idx);
+    bool test(int idx) const;
+    int find_prev(int idx) const;
+    int find_next_unset(int idx) const;
+
+private:
+    std::vector<uint64_t> words;
+};
@@ -0,0 +1,186 @@
+﻿/*!
+ * @brief LZ77系の簡易圧縮・伸張処理
+ * @details
+ * 圧縮データはシーケンスの並びである. 各シーケンスは以下の形式をとる.
+ * - トークン (1バイト): 上位4ビットがリテラル長、下位4ビットが一致長 - 4
+ * - 拡張リテラル長 (リテラル長が15以上の時): 255未満の値が出るまで加算する
+ * - リテラル
+ * - 一致位置のオフセット (2バイト、リトルエンディアン)
+ * - 拡張一致長 (一致長 - 4 が15以上の時): 拡張リテラル長と同じ形式
+ * 最後のシーケンスはリテラルのみで終わる.
+ */
+
+#include "util/lz-codec.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr auto HASH_BITS = 14;
+constexpr size_t TOKEN_LENGTH_MAX = 15;
+
+uint32_t read_u32(const char *p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+size_t hash_sequence(uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void write_length(std::string &dst, size_t length)
+{
+    for (; length >= 255; length -= 255) {
+        dst.push_back(static_cast<char>(255));
+    }
+
+    dst.push_back(static_cast<char>(length));
+}
+
+/*!
+ * @brief シーケンスを1つ書き出す
+ * @param dst 書き出し先
+ * @param literals リテラル
+ * @param match_length 一致長 (最後のシーケンスなら0)
+ * @param offset 一致位置のオフセット
+ */
+void write_sequence(std::string &dst, std::string_view literals, size_t match_length, size_t offset)
+{
+    const auto literal_token = std::min(literals.length(), TOKEN_LENGTH_MAX);
+    const auto match_token = (match_length > 0) ? std::min(match_length - MIN_MATCH, TOKEN_LENGTH_MAX) : 0;
+    dst.push_back(static_cast<char>((literal_token << 4) | match_token));
+    if (literal_token == TOKEN_LENGTH_MAX) {
+        write_length(dst, literals.length() - TOKEN_LENGTH_MAX);
+    }
+
+    dst.append(literals);
+    if (match_length == 0) {
+        return;
+    }
+
+    dst.push_back(static_cast<char>(offset & 0xff));
+    dst.push_back(static_cast<char>(offset >> 8));
+    if (match_token == TOKEN_LENGTH_MAX) {
+        write_length(dst, match_length - MIN_MATCH - TOKEN_LENGTH_MAX);
+    }
+}
+
+/*!
+ * @brief 拡張長を読み込む
+ * @param src 圧縮データ
+ * @param pos 読み込み位置 (読み込んだ分だけ進める)
+ * @param length トークンの長さ (拡張長を加算する)
+ * @return 圧縮データが途切れていなければtrue
+ */
+bool read_length(std::string_view src, size_t &pos, size_t &length)
+{
+    while (pos < src.length()) {
+        const auto v = static_cast<uint8_t>(src[pos++]);
+        length += v;
+        if (v < 255) {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
+
+/*!
+ * @brief データを圧縮する
+ * @param src 圧縮するデータ
+ * @return 圧縮データ
+ * @details 直近に現れた4バイト列をハッシュ表で探し、見つかった位置からの最長一致を貪欲に採用する.
+ */
+std::string lz_compress(std::string_view src)
+{
+    std::string dst;
+    dst.reserve(src.length() / 2 + 16);
+    std::vector<int> last_positions(1U << HASH_BITS, -1);
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + MIN_MATCH <= src.length()) {
+        const auto sequence = read_u32(&src[pos]);
+        auto &last_position = last_positions[hash_sequence(sequence)];
+        const auto candidate = last_position;
+        last_position = static_cast<int>(pos);
+        if ((candidate < 0) || (pos - candidate > MAX_OFFSET) || (read_u32(&src[candidate]) != sequence)) {
+            pos++;
+            continue;
+        }
+
+        auto length = MIN_MATCH;
+        while ((pos + length < src.length()) && (src[candidate + length] == src[pos + length])) {
+            length++;
+        }
+
+        write_sequence(dst, src.substr(anchor, pos - anchor), length, pos - candidate);
+        pos += length;
+        anchor = pos;
+    }
+
+    write_sequence(dst, src.substr(anchor), 0, 0);
+    return dst;
+}
+
+/*!
+ * @brief 圧縮データを伸張する
+ * @param src 圧縮データ
+ * @param raw_size 伸張後の長さ
+ * @return 伸張したデータ. 圧縮データが壊れていればstd::nullopt
+ */
+std::optional<std::string> lz_decompress(std::string_view src, size_t raw_size)
+{
+    std::string dst;
+    dst.reserve(raw_size);
+    size_t pos = 0;
+    while (pos < src.length()) {
+        const auto token = static_cast<uint8_t>(src[pos++]);
+        size_t literal_length = token >> 4;
+        if ((literal_length == TOKEN_LENGTH_MAX) && !read_length(src, pos, literal_length)) {
+            return std::nullopt;
+        }
+
+        if ((literal_length > src.length() - pos) || (dst.length() + literal_length > raw_size)) {
+            return std::nullopt;
+        }
+
+        dst.append(src.substr(pos, literal_length));
+        pos += literal_length;
+        if (pos == src.length()) {
+            break;
+        }
+
+        if (pos + 2 > src.length()) {
+            return std::nullopt;
+        }
+
+        const size_t offset = static_cast<uint8_t>(src[pos]) | (static_cast<uint8_t>(src[pos + 1]) << 8);
+        pos += 2;
+        size_t match_length = (token & TOKEN_LENGTH_MAX) + MIN_MATCH;
+        if ((match_length == TOKEN_LENGTH_MAX + MIN_MATCH) && !read_length(src, pos, match_length)) {
+            return std::nullopt;
+        }
+
+        if ((offset == 0) || (offset > dst.length()) || (dst.length() + match_length > raw_size)) {
+            return std::nullopt;
+        }
+
+        const auto start = dst.length() - offset;
+        for (size_t i = 0; i < match_length; i++) {
+            dst.push_back(dst[start + i]);
+        }
+    }
+
+    if (dst.length() != raw_size) {
+        return std::nullopt;
+    }
+
+    return dst;
+}
@@ -0,0 +1,8 @@
+﻿#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+std::string lz_compress(std::string_view src);
+std::optional<std::string> lz_decompress(std::string_view src, size_t raw_size);
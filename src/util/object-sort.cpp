@@ -37,9 +37,10 @@ static int get_item_sort_rank(const ItemEntity &item)
  * @param o_ptr 比較対象オブジェクトの構造体参照ポインタ1
  * @param o_value o_ptrのアイテム価値（手動であらかじめ代入する必要がある？）
  * @param j_ptr 比較対象オブジェクトの構造体参照ポインタ2
+ * @param j_value j_ptrのアイテム価値 (省略時はここで計算する)
  * @return o_ptrの方が上位ならばTRUEを返す。
  */
-bool object_sort_comp(PlayerType *player_ptr, ItemEntity *o_ptr, int32_t o_value, ItemEntity *j_ptr)
+bool object_sort_comp(PlayerType *player_ptr, ItemEntity *o_ptr, int32_t o_value, ItemEntity *j_ptr, std::optional<int32_t> j_value)
 {
     if (!j_ptr->is_valid()) {
         return true;
@@ -150,5 +151,5 @@ bool object_sort_comp(PlayerType *player_ptr, ItemEntity *o_ptr, int32_t o_value
         break;
     }
 
-    return o_value > j_ptr->get_price();
+    return o_value > (j_value ? *j_value : j_ptr->get_price());
 }
@@ -1,7 +1,8 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include <optional>
 
 class ItemEntity;
 class PlayerType;
-bool object_sort_comp(PlayerType *player_ptr, ItemEntity *o_ptr, int32_t o_value, ItemEntity *j_ptr);
+bool object_sort_comp(PlayerType *player_ptr, ItemEntity *o_ptr, int32_t o_value, ItemEntity *j_ptr, std::optional<int32_t> j_value = std::nullopt);
@@ -3,7 +3,9 @@
 #include "system/angband-exceptions.h"
 #include "term/z-rand.h"
 #include <algorithm>
+#include <cstdint>
 #include <exception>
+#include <limits>
 #include <stdexcept>
 #include <tuple>
 #include <vector>
@@ -30,7 +32,8 @@ public:
      */
     void clear()
     {
-        return item_list_.clear();
+        item_list_.clear();
+        alias_list_.clear();
     }
 
     /**
@@ -51,6 +54,56 @@ public:
             // 二分探索を行うため、probは累積値を格納する
             auto cumulative_prob = item_list_.empty() ? 0 : std::get<1>(item_list_.back());
             item_list_.emplace_back(id, cumulative_prob + prob);
+            alias_list_.clear();
+        }
+    }
+
+    /**
+     * @brief 抽選を定数時間で行うための別名テーブル (Walker's alias method) を構築する
+     *
+     * 登録済みの項目から Vose の方法で別名テーブルを構築する。
+     * 構築後は pick_one_at_random() が二分探索の代わりに別名テーブルを用いる。
+     * 各項目が選択される確率は構築前と全く同じである。
+     * 項目を追加もしくは削除すると別名テーブルは破棄される。
+     * 同じテーブルから何度も抽選する場合にのみ構築する意味がある。
+     */
+    void build_alias_table()
+    {
+        const auto count = item_list_.size();
+        const int64_t total = total_prob();
+        alias_list_.assign(count, { 0, 0 });
+
+        // 各項目の確率を項目数倍し、平均がちょうど total になるよう揃える
+        std::vector<int64_t> scaled_probs(count);
+        std::vector<size_t> small_items;
+        std::vector<size_t> large_items;
+        auto prev_cumulative_prob = 0;
+        for (size_t i = 0; i < count; i++) {
+            const auto cumulative_prob = std::get<1>(item_list_[i]);
+            scaled_probs[i] = static_cast<int64_t>(cumulative_prob - prev_cumulative_prob) * static_cast<int64_t>(count);
+            prev_cumulative_prob = cumulative_prob;
+            (scaled_probs[i] < total ? small_items : large_items).push_back(i);
+        }
+
+        // 平均に満たない項目の枠の残りを、平均を超える項目で埋める
+        while (!small_items.empty() && !large_items.empty()) {
+            const auto small = small_items.back();
+            small_items.pop_back();
+            const auto large = large_items.back();
+            alias_list_[small] = { static_cast<int>(scaled_probs[small]), large };
+            scaled_probs[large] -= total - scaled_probs[small];
+            if (scaled_probs[large] < total) {
+                large_items.pop_back();
+                small_items.push_back(large);
+            }
+        }
+
+        for (const auto i : large_items) {
+            alias_list_[i] = { static_cast<int>(total), i };
+        }
+
+        for (const auto i : small_items) {
+            alias_list_[i] = { static_cast<int>(total), i };
         }
     }
 
@@ -112,6 +165,10 @@ public:
             THROW_EXCEPTION(std::runtime_error, "There is no entry in the probability table.");
         }
 
+        if (!alias_list_.empty()) {
+            return pick_one_by_alias();
+        }
+
         // probの合計の範囲からランダムでkeyを取得し、二分探索で選択する項目を決定する
         const int key = randint0(total_prob());
         auto it = std::partition_point(item_list_.begin(), item_list_.end(), [key](const auto &i) { return std::get<1>(i) <= key; });
@@ -140,4 +197,33 @@ public:
 private:
     /** 項目のIDと確率のセットを格納する配列 */
     std::vector<std::tuple<IdType, int>> item_list_;
+
+    /** 別名テーブル. 各枠で自身を選ぶ閾値と、閾値以上の時に選ぶ項目の添字のセットを格納する */
+    std::vector<std::tuple<int, size_t>> alias_list_;
+
+    /**
+     * @brief 別名テーブルを用いて項目を1つ選択する
+     *
+     * 枠の選択と枠内での選択を、可能であれば1回の乱数で同時に行う。
+     *
+     * @return 選択された項目のID
+     */
+    IdType pick_one_by_alias() const
+    {
+        const auto count = static_cast<int>(alias_list_.size());
+        const auto total = total_prob();
+        int slot;
+        int key;
+        if (static_cast<int64_t>(count) * total <= std::numeric_limits<int>::max()) {
+            const auto r = randint0(count * total);
+            slot = r / total;
+            key = r % total;
+        } else {
+            slot = randint0(count);
+            key = randint0(total);
+        }
+
+        const auto &[threshold, alias] = alias_list_[slot];
+        return std::get<0>(item_list_[key < threshold ? slot : alias]);
+    }
 };
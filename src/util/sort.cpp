@@ -12,678 +12,206 @@
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
 #include "system/terrain-type-definition.h"
+#include "util/enum-converter.h"
+#include "util/point-2d.h"
+#include <array>
+#include <tuple>
 
-/*
- * @brief クイックソートの実行 / Quick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
- */
-static void exe_ang_sort(PlayerType *player_ptr, vptr u, vptr v, int p, int q, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int))
-{
-    if (p >= q) {
-        return;
-    }
-
-    int z = p;
-    int a = p;
-    int b = q;
-    while (true) {
-        /* Slide i2 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, b, z)) {
-            b--;
-        }
-
-        /* Slide i1 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, z, a)) {
-            a++;
-        }
-
-        if (a >= b) {
-            break;
-        }
-
-        (*ang_sort_swap)(player_ptr, u, v, a, b);
-
-        a++, b--;
-    }
-
-    /* Recurse left side */
-    exe_ang_sort(player_ptr, u, v, p, b, ang_sort_comp, ang_sort_swap);
-
-    /* Recurse right side */
-    exe_ang_sort(player_ptr, u, v, b + 1, q, ang_sort_comp, ang_sort_swap);
-}
-
-/*
- * @brief クイックソートの受け付け / Accepting auick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
+namespace {
+/*!
+ * @brief プレイヤーからの距離の近似値 (2倍値) を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param pos 座標
+ * @return 距離の2倍の近似値
  */
-void ang_sort(PlayerType *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int))
+int calc_double_distance(const PlayerType *player_ptr, const Pos2D &pos)
 {
-    exe_ang_sort(player_ptr, u, v, 0, n - 1, ang_sort_comp, ang_sort_swap);
+    const auto kx = std::abs(pos.x - player_ptr->x);
+    const auto ky = std::abs(pos.y - player_ptr->y);
+    return (kx > ky) ? (kx + kx + ky) : (ky + ky + kx);
 }
 
-/*
- * Sorting hook -- comp function -- by "distance to player"
- *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by double-distance to the player.
+/*!
+ * @brief 注目すべき度合いで並べ替えるためのキーを返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param pos 座標
+ * @return 並べ替えのキー (小さいほど先頭)
+ * @details
+ * プレイヤーのいるマス、見えているモンスター (ユニーク、あやしい影、未知のモンスター、高レベル (既知の場合)、種族番号の大きい順)、
+ * アイテムのあるマス、地形の表示優先度の高い順に並べ、最後にプレイヤーからの距離で並べる.
  */
-bool ang_sort_comp_distance(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+std::array<int, 10> calc_importance_key(PlayerType *player_ptr, const Pos2D &pos)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
+    const auto &floor = *player_ptr->current_floor_ptr;
+    const auto &grid = floor.get_grid(pos);
+    std::array<int, 10> key{};
+    key[0] = ((pos.y == player_ptr->y) && (pos.x == player_ptr->x)) ? 0 : 1;
 
-    /* Absolute distance components */
-    POSITION kx = x[a];
-    kx -= player_ptr->x;
-    kx = std::abs(kx);
-    POSITION ky = y[a];
-    ky -= player_ptr->y;
-    ky = std::abs(ky);
-
-    /* Approximate Double Distance to the first point */
-    POSITION da = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
-
-    /* Absolute distance components */
-    kx = x[b];
-    kx -= player_ptr->x;
-    kx = std::abs(kx);
-    ky = y[b];
-    ky -= player_ptr->y;
-    ky = std::abs(ky);
-
-    /* Approximate Double Distance to the first point */
-    POSITION db = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
+    const auto &monster = floor.m_list[grid.m_idx];
+    const auto is_monster_visible = (grid.m_idx != 0) && monster.ml;
+    key[1] = is_monster_visible ? 0 : 1;
+    if (is_monster_visible) {
+        const auto &ap_monrace = monraces_info[monster.ap_r_idx];
+        key[2] = ap_monrace.kind_flags.has(MonsterKindType::UNIQUE) ? 0 : 1;
+        key[3] = monster.mflag2.has(MonsterConstantFlagType::KAGE) ? 0 : 1;
+        key[4] = (ap_monrace.r_tkills != 0) ? 1 : 0;
+        key[5] = (ap_monrace.r_tkills != 0) ? -ap_monrace.level : 0;
+        key[6] = -enum2i(monster.ap_r_idx);
+    }
 
-    /* Compare the distances */
-    return da <= db;
+    key[7] = grid.o_idx_list.empty() ? 1 : 0;
+    key[8] = -terrains_info[grid.feat].priority;
+    key[9] = calc_double_distance(player_ptr, pos);
+    return key;
 }
 
-/*
- * Sorting hook -- comp function -- by importance level of grids
- *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by level of monster
+/*!
+ * @brief y/x座標それぞれの配列を、座標毎に求めたキーの昇順に並べ替える
+ * @param ys y座標の配列
+ * @param xs x座標の配列
+ * @param get_key 座標からキーを求める関数
  */
-bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+template <typename KeyFunc>
+void sort_positions_by_key(std::vector<POSITION> &ys, std::vector<POSITION> &xs, KeyFunc get_key)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-    grid_type *ca_ptr = &player_ptr->current_floor_ptr->grid_array[y[a]][x[a]];
-    grid_type *cb_ptr = &player_ptr->current_floor_ptr->grid_array[y[b]][x[b]];
-    MonsterEntity *ma_ptr = &player_ptr->current_floor_ptr->m_list[ca_ptr->m_idx];
-    MonsterEntity *mb_ptr = &player_ptr->current_floor_ptr->m_list[cb_ptr->m_idx];
-    MonsterRaceInfo *ap_ra_ptr, *ap_rb_ptr;
-
-    /* The player grid */
-    if (y[a] == player_ptr->y && x[a] == player_ptr->x) {
-        return true;
-    }
-
-    if (y[b] == player_ptr->y && x[b] == player_ptr->x) {
-        return false;
-    }
-
-    /* Extract monster race */
-    if (ca_ptr->m_idx && ma_ptr->ml) {
-        ap_ra_ptr = &monraces_info[ma_ptr->ap_r_idx];
-    } else {
-        ap_ra_ptr = nullptr;
-    }
-
-    if (cb_ptr->m_idx && mb_ptr->ml) {
-        ap_rb_ptr = &monraces_info[mb_ptr->ap_r_idx];
-    } else {
-        ap_rb_ptr = nullptr;
-    }
-
-    if (ap_ra_ptr && !ap_rb_ptr) {
-        return true;
-    }
-
-    if (!ap_ra_ptr && ap_rb_ptr) {
-        return false;
-    }
-
-    /* Compare two monsters */
-    if (ap_ra_ptr && ap_rb_ptr) {
-        /* Unique monsters first */
-        if (ap_ra_ptr->kind_flags.has(MonsterKindType::UNIQUE) && ap_rb_ptr->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-            return true;
-        }
-        if (ap_ra_ptr->kind_flags.has_not(MonsterKindType::UNIQUE) && ap_rb_ptr->kind_flags.has(MonsterKindType::UNIQUE)) {
-            return false;
-        }
-
-        /* Shadowers first (あやしい影) */
-        if (ma_ptr->mflag2.has(MonsterConstantFlagType::KAGE) && mb_ptr->mflag2.has_not(MonsterConstantFlagType::KAGE)) {
-            return true;
-        }
-        if (ma_ptr->mflag2.has_not(MonsterConstantFlagType::KAGE) && mb_ptr->mflag2.has(MonsterConstantFlagType::KAGE)) {
-            return false;
-        }
-
-        /* Unknown monsters first */
-        if (!ap_ra_ptr->r_tkills && ap_rb_ptr->r_tkills) {
-            return true;
-        }
-        if (ap_ra_ptr->r_tkills && !ap_rb_ptr->r_tkills) {
-            return false;
-        }
-
-        /* Higher level monsters first (if known) */
-        if (ap_ra_ptr->r_tkills && ap_rb_ptr->r_tkills) {
-            if (ap_ra_ptr->level > ap_rb_ptr->level) {
-                return true;
-            }
-            if (ap_ra_ptr->level < ap_rb_ptr->level) {
-                return false;
-            }
-        }
-
-        /* Sort by index if all conditions are same */
-        if (ma_ptr->ap_r_idx > mb_ptr->ap_r_idx) {
-            return true;
-        }
-        if (ma_ptr->ap_r_idx < mb_ptr->ap_r_idx) {
-            return false;
-        }
-    }
-
-    /* An object get higher priority */
-    if (!player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty()) {
-        return true;
-    }
-
-    if (player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && !player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty()) {
-        return false;
+    std::vector<Pos2D> positions;
+    positions.reserve(ys.size());
+    for (size_t i = 0; i < ys.size(); i++) {
+        positions.emplace_back(ys[i], xs[i]);
     }
 
-    /* Priority from the terrain */
-    if (terrains_info[ca_ptr->feat].priority > terrains_info[cb_ptr->feat].priority) {
-        return true;
+    sort_by_key(positions.begin(), positions.end(), get_key);
+    for (size_t i = 0; i < positions.size(); i++) {
+        ys[i] = positions[i].y;
+        xs[i] = positions[i].x;
     }
-
-    if (terrains_info[ca_ptr->feat].priority < terrains_info[cb_ptr->feat].priority) {
-        return false;
-    }
-
-    /* If all conditions are same, compare distance */
-    return ang_sort_comp_distance(player_ptr, u, v, a, b);
 }
-
-/*
- * Sorting hook -- swap function -- by "distance to player"
- *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by distance to the player.
- */
-void ang_sort_swap_position(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-
-    POSITION temp = x[a];
-    x[a] = x[b];
-    x[b] = temp;
-
-    temp = y[a];
-    y[a] = y[b];
-    y[b] = temp;
 }
 
-/*
- * Sorting hook -- Comp function -- see below
- *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
+/*!
+ * @brief 座標をプレイヤーから近い順に並べ替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param ys y座標の配列
+ * @param xs x座標の配列
  */
-bool ang_sort_art_comp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_positions_by_distance(PlayerType *player_ptr, std::vector<POSITION> &ys, std::vector<POSITION> &xs)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    const auto w1 = i2enum<FixedArtifactId>(who[a]);
-    const auto w2 = i2enum<FixedArtifactId>(who[b]);
-
-    int z1;
-    int z2;
-
-    /* Sort by total kills */
-    const auto &artifact_w1 = ArtifactsInfo::get_instance().get_artifact(w1);
-    const auto &artifact_w2 = ArtifactsInfo::get_instance().get_artifact(w2);
-    if (*why >= 3) {
-        /* Extract total kills */
-        z1 = enum2i(artifact_w1.bi_key.tval());
-        z2 = enum2i(artifact_w2.bi_key.tval());
-
-        /* Compare total kills */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Sort by monster level */
-    if (*why >= 2) {
-        /* Extract levels */
-        z1 = artifact_w1.bi_key.sval().value();
-        z2 = artifact_w2.bi_key.sval().value();
-
-        /* Compare levels */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Sort by monster experience */
-    if (*why >= 1) {
-        /* Extract experience */
-        z1 = artifact_w1.level;
-        z2 = artifact_w2.level;
-
-        /* Compare experience */
-        if (z1 < z2) {
-            return true;
-        }
-
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Compare indexes */
-    return w1 <= w2;
+    sort_positions_by_key(ys, xs, [player_ptr](const Pos2D &pos) { return calc_double_distance(player_ptr, pos); });
 }
 
-/*
- * Sorting hook -- Swap function -- see below
- *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
+/*!
+ * @brief 座標を注目すべき度合いの高い順に並べ替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param ys y座標の配列
+ * @param xs x座標の配列
  */
-void ang_sort_art_swap(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
-}
-
-bool ang_sort_comp_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_positions_by_importance(PlayerType *player_ptr, std::vector<POSITION> &ys, std::vector<POSITION> &xs)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    const auto &quest_list = QuestList::get_instance();
-    QuestId *q_num = (QuestId *)u;
-    const auto *qa = &quest_list[q_num[a]];
-    const auto *qb = &quest_list[q_num[b]];
-    return (qa->comptime != qb->comptime) ? (qa->comptime < qb->comptime) : (qa->level <= qb->level);
-}
-
-void ang_sort_swap_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    QuestId *q_num = (QuestId *)u;
-    QuestId tmp = q_num[a];
-    q_num[a] = q_num[b];
-    q_num[b] = tmp;
+    sort_positions_by_key(ys, xs, [player_ptr](const Pos2D &pos) { return calc_importance_key(player_ptr, pos); });
 }
 
 /*!
- * @brief ペット入りモンスターボールをソートするための比較関数
- * @param u 所持品配列の参照ポインタ
- * @param v 未使用
- * @param a 所持品ID1
- * @param b 所持品ID2
- * @return 1の方が大であればTRUE
+ * @brief 固定アーティファクトを並べ替える
+ * @param artifact_ids 固定アーティファクトIDの配列
+ * @param why 並べ替えの基準 (3以上ならtval、2以上ならsval、1以上なら生成階の順. 最後にIDの順)
  */
-bool ang_sort_comp_pet(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_artifact_ids(std::vector<FixedArtifactId> &artifact_ids, uint16_t why)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
-    MonsterEntity *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
-    MonsterEntity *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
-    MonsterRaceInfo *r_ptr1 = &monraces_info[m_ptr1->r_idx];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[m_ptr2->r_idx];
-
-    if (m_ptr1->is_named() && !m_ptr2->is_named()) {
-        return true;
-    }
-
-    if (m_ptr2->is_named() && !m_ptr1->is_named()) {
-        return false;
-    }
-
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return true;
-    }
-
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return false;
-    }
-
-    if (r_ptr1->level > r_ptr2->level) {
-        return true;
-    }
-
-    if (r_ptr2->level > r_ptr1->level) {
-        return false;
-    }
-
-    if (m_ptr1->hp > m_ptr2->hp) {
-        return true;
-    }
-
-    if (m_ptr2->hp > m_ptr1->hp) {
-        return false;
-    }
-
-    return w1 <= w2;
+    const auto &artifacts = ArtifactsInfo::get_instance();
+    sort_by_key(artifact_ids.begin(), artifact_ids.end(), [&artifacts, why](FixedArtifactId fa_id) {
+        const auto &artifact = artifacts.get_artifact(fa_id);
+        return std::array<int, 4>{
+            (why >= 3) ? enum2i(artifact.bi_key.tval()) : 0,
+            (why >= 2) ? artifact.bi_key.sval().value() : 0,
+            (why >= 1) ? artifact.level : 0,
+            enum2i(fa_id),
+        };
+    });
 }
 
 /*!
- * @brief モンスター種族情報を特定の基準によりソートするための比較処理
- * Sorting hook -- Comp function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 条件基準ID
- * @param a 比較するモンスター種族のID1
- * @param b 比較するモンスター種族のID2
- * @return 2の方が大きければTRUEを返す
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
+ * @brief クエストを達成時刻の順 (同時刻なら階層の順) に並べ替える
+ * @param quest_ids クエストIDの配列
  */
-bool ang_sort_comp_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_quest_ids(std::vector<QuestId> &quest_ids)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    MonsterRaceId *who = (MonsterRaceId *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    auto w1 = who[a];
-    auto w2 = who[b];
-
-    int z1, z2;
-
-    /* Sort by player kills */
-    if (*why >= 4) {
-        /* Extract player kills */
-        z1 = monraces_info[w1].r_pkills;
-        z2 = monraces_info[w2].r_pkills;
-
-        /* Compare player kills */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Sort by total kills */
-    if (*why >= 3) {
-        /* Extract total kills */
-        z1 = monraces_info[w1].r_tkills;
-        z2 = monraces_info[w2].r_tkills;
-
-        /* Compare total kills */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Sort by monster level */
-    if (*why >= 2) {
-        /* Extract levels */
-        z1 = monraces_info[w1].level;
-        z2 = monraces_info[w2].level;
-
-        /* Compare levels */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Sort by monster experience */
-    if (*why >= 1) {
-        /* Extract experience */
-        z1 = monraces_info[w1].mexp;
-        z2 = monraces_info[w2].mexp;
-
-        /* Compare experience */
-        if (z1 < z2) {
-            return true;
-        }
-        if (z1 > z2) {
-            return false;
-        }
-    }
-
-    /* Compare indexes */
-    return w1 <= w2;
+    const auto &quest_list = QuestList::get_instance();
+    sort_by_key(quest_ids.begin(), quest_ids.end(), [&quest_list](QuestId quest_id) {
+        const auto &quest = quest_list[quest_id];
+        return std::make_pair(quest.comptime, quest.level);
+    });
 }
 
 /*!
- * @brief モンスター種族情報を特定の基準によりソートするためのスワップ処理
- * Sorting hook -- Swap function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @details
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
+ * @brief ペット入りモンスターボールに入れるペットの候補を並べ替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param pet_indices ペットのモンスターIDの配列
+ * @details 名前付き、ユニーク、高レベル、HPの多い順に並べ、最後にIDの順に並べる.
  */
-void ang_sort_swap_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_pet_indices(PlayerType *player_ptr, std::vector<MONSTER_IDX> &pet_indices)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder;
-
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    const auto &floor = *player_ptr->current_floor_ptr;
+    sort_by_key(pet_indices.begin(), pet_indices.end(), [&floor](MONSTER_IDX m_idx) {
+        const auto &monster = floor.m_list[m_idx];
+        const auto &monrace = monraces_info[monster.r_idx];
+        return std::make_tuple(!monster.is_named(), monrace.kind_flags.has_not(MonsterKindType::UNIQUE), -monrace.level, -monster.hp, m_idx);
+    });
 }
 
-/*
- * hook function to sort monsters by level
+/*!
+ * @brief 解放するペットの候補を並べ替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param pet_indices ペットのモンスターIDの配列
+ * @details 騎乗中、名前付き、分裂で生まれたものでない、ユニーク、高レベル、HPの多い順に並べ、最後にIDの順に並べる.
  */
-bool ang_sort_comp_monster_level(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_pet_indices_to_dismiss(PlayerType *player_ptr, std::vector<MONSTER_IDX> &pet_indices)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    MonsterRaceId *who = (MonsterRaceId *)(u);
-
-    auto w1 = who[a];
-    auto w2 = who[b];
-
-    MonsterRaceInfo *r_ptr1 = &monraces_info[w1];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[w2];
-
-    if (r_ptr2->level > r_ptr1->level) {
-        return true;
-    }
-
-    if (r_ptr1->level > r_ptr2->level) {
-        return false;
-    }
-
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return true;
-    }
-
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return false;
-    }
-
-    return w1 <= w2;
+    const auto &floor = *player_ptr->current_floor_ptr;
+    const auto riding = player_ptr->riding;
+    sort_by_key(pet_indices.begin(), pet_indices.end(), [&floor, riding](MONSTER_IDX m_idx) {
+        const auto &monster = floor.m_list[m_idx];
+        const auto &monrace = monraces_info[monster.r_idx];
+        return std::make_tuple(m_idx != riding, !monster.is_named(), monster.parent_m_idx != 0, monrace.kind_flags.has_not(MonsterKindType::UNIQUE),
+            -monrace.level, -monster.hp, m_idx);
+    });
 }
 
 /*!
- * @brief ペットになっているモンスターをソートするための比較処理
- * @param u モンスターの構造体配列
- * @param v 未使用
- * @param a 比較対象のモンスターID1
- * @param b 比較対象のモンスターID2
- * @return 2番目が大ならばTRUEを返す
+ * @brief モンスター種族を並べ替える
+ * @param monrace_ids モンスター種族IDの配列
+ * @param why 並べ替えの基準 (4以上ならこのゲームで倒した数、3以上なら全ゲームで倒した数、2以上ならレベル、1以上なら経験値の順. 最後にIDの順)
  */
-bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_monrace_ids(std::vector<MonsterRaceId> &monrace_ids, uint16_t why)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
-    MonsterEntity *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
-    MonsterEntity *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
-    MonsterRaceInfo *r_ptr1 = &monraces_info[m_ptr1->r_idx];
-    MonsterRaceInfo *r_ptr2 = &monraces_info[m_ptr2->r_idx];
-
-    if (w1 == player_ptr->riding) {
-        return true;
-    }
-
-    if (w2 == player_ptr->riding) {
-        return false;
-    }
-
-    if (m_ptr1->is_named() && !m_ptr2->is_named()) {
-        return true;
-    }
-
-    if (m_ptr2->is_named() && !m_ptr1->is_named()) {
-        return false;
-    }
-
-    if (!m_ptr1->parent_m_idx && m_ptr2->parent_m_idx) {
-        return true;
-    }
-
-    if (!m_ptr2->parent_m_idx && m_ptr1->parent_m_idx) {
-        return false;
-    }
-
-    if (r_ptr1->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr2->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return true;
-    }
-
-    if (r_ptr2->kind_flags.has(MonsterKindType::UNIQUE) && r_ptr1->kind_flags.has_not(MonsterKindType::UNIQUE)) {
-        return false;
-    }
-
-    if (r_ptr1->level > r_ptr2->level) {
-        return true;
-    }
-
-    if (r_ptr2->level > r_ptr1->level) {
-        return false;
-    }
-
-    if (m_ptr1->hp > m_ptr2->hp) {
-        return true;
-    }
-
-    if (m_ptr2->hp > m_ptr1->hp) {
-        return false;
-    }
-
-    return w1 <= w2;
+    sort_by_key(monrace_ids.begin(), monrace_ids.end(), [why](MonsterRaceId monrace_id) {
+        const auto &monrace = monraces_info[monrace_id];
+        return std::array<int, 5>{
+            (why >= 4) ? monrace.r_pkills : 0,
+            (why >= 3) ? monrace.r_tkills : 0,
+            (why >= 2) ? monrace.level : 0,
+            (why >= 1) ? monrace.mexp : 0,
+            enum2i(monrace_id),
+        };
+    });
 }
 
 /*!
- * @brief フロア保存時のgrid情報テンプレートをソートするための比較処理
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @return aの方が大きければtrue
+ * @brief モンスター種族をレベルの順 (同レベルならユニークを後) に並べ替える
+ * @param monrace_ids モンスター種族IDの配列
  */
-bool ang_sort_comp_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_monrace_ids_by_level(std::vector<MonsterRaceId> &monrace_ids)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    grid_template_type *who = (grid_template_type *)(u);
-
-    uint16_t o1 = who[a].occurrence;
-    uint16_t o2 = who[b].occurrence;
-
-    return o2 <= o1;
+    sort_by_key(monrace_ids.begin(), monrace_ids.end(), [](MonsterRaceId monrace_id) {
+        const auto &monrace = monraces_info[monrace_id];
+        return std::make_tuple(monrace.level, monrace.kind_flags.has(MonsterKindType::UNIQUE), monrace_id);
+    });
 }
 
 /*!
- * @brief フロア保存時のgrid情報テンプレートをソートするためのスワップ処理 / Sorting hook -- Swap function
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
+ * @brief フロア保存時のgrid情報テンプレートを出現数の多い順に並べ替える
+ * @param templates gridテンプレートの配列
  */
-void ang_sort_swap_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b)
+void sort_grid_templates(std::vector<grid_template_type> &templates)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    grid_template_type *who = (grid_template_type *)(u);
-    grid_template_type holder;
-
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    sort_by_key(templates.begin(), templates.end(), [](const grid_template_type &ct_ref) { return -static_cast<int>(ct_ref.occurrence); });
 }
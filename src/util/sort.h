@@ -1,28 +1,51 @@
 ﻿#pragma once
 
 #include "system/angband.h"
-
-#include "system/player-type-definition.h"
-void ang_sort(PlayerType *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(PlayerType *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(PlayerType *, vptr, vptr, int, int));
-
-bool ang_sort_comp_distance(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_importance(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_position(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_art_comp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_art_swap(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_quest_num(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_pet(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_hook(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_monster_level(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_pet_dismiss(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-
-bool ang_sort_comp_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_cave_temp(PlayerType *player_ptr, vptr u, vptr v, int a, int b);
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum class FixedArtifactId : short;
+enum class MonsterRaceId : int16_t;
+enum class QuestId : int16_t;
+struct grid_template_type;
+class PlayerType;
+
+/*!
+ * @brief 要素毎にキーを1回だけ計算し、キーの昇順に並べ替える
+ * @param first 並べ替える範囲の先頭
+ * @param last 並べ替える範囲の末尾
+ * @param get_key 要素からキーを求める関数
+ * @details
+ * 比較の度に条件を計算し直さずに済むよう、先にキーを求めてから std::sort() で並べ替える.
+ * キーが等しい要素は元の順序を保つ.
+ */
+template <typename Iterator, typename KeyFunc>
+void sort_by_key(Iterator first, Iterator last, KeyFunc get_key)
+{
+    using Value = typename std::iterator_traits<Iterator>::value_type;
+    using Key = std::invoke_result_t<KeyFunc &, const Value &>;
+    std::vector<Value> values(first, last);
+    std::vector<std::pair<Key, size_t>> keys;
+    keys.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        keys.emplace_back(get_key(values[i]), i);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    for (const auto &key : keys) {
+        *first++ = values[key.second];
+    }
+}
+
+void sort_positions_by_distance(PlayerType *player_ptr, std::vector<POSITION> &ys, std::vector<POSITION> &xs);
+void sort_positions_by_importance(PlayerType *player_ptr, std::vector<POSITION> &ys, std::vector<POSITION> &xs);
+void sort_artifact_ids(std::vector<FixedArtifactId> &artifact_ids, uint16_t why);
+void sort_quest_ids(std::vector<QuestId> &quest_ids);
+void sort_pet_indices(PlayerType *player_ptr, std::vector<MONSTER_IDX> &pet_indices);
+void sort_pet_indices_to_dismiss(PlayerType *player_ptr, std::vector<MONSTER_IDX> &pet_indices);
+void sort_monrace_ids(std::vector<MonsterRaceId> &monrace_ids, uint16_t why);
+void sort_monrace_ids_by_level(std::vector<MonsterRaceId> &monrace_ids);
+void sort_grid_templates(std::vector<grid_template_type> &templates);
@@ -12,10 +12,11 @@
 #include "term/term-color-types.h"
 #include "util/int-char-converter.h"
 #include "world/world.h"
+#include <algorithm>
 #include <deque>
-#include <map>
-#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Used in msg_print() for "buffering" */
 bool msg_flag;
@@ -27,42 +28,190 @@ namespace {
 /*! 表示するメッセージの先頭位置 */
 static int msg_head_pos = 0;
 
-using msg_sp = std::shared_ptr<const std::string>;
-using msg_wp = std::weak_ptr<const std::string>;
+/*! 同一メッセージの繰り返しを纏める最大数 */
+constexpr auto MAX_REPEAT_COUNT = 1000;
 
-/** メッセージが同一かどうかを比較するためのラムダ式 */
-auto string_ptr_cmp = [](const std::string *a, const std::string *b) { return *a < *b; };
+/*!
+ * @brief メッセージ履歴
+ * @details
+ * 文字列は同一の内容を1つだけ保持し、ハッシュ表で検索する. 参照数が0になった文字列の領域は再利用する.
+ * 履歴は文字列の番号と繰り返し回数の組を固定長のリングバッファに保持する.
+ * 直前と同じメッセージは繰り返し回数を増やすだけで纏め、「～ <xNN>」の文字列は読み出す時に作る.
+ */
+class MessageHistory {
+public:
+    int size() const;
+    std::string get(int age) const;
+    bool add_repeat(std::string_view str);
+    void push_front(std::string_view str, int count);
+
+private:
+    /*!
+     * @brief 共有されるメッセージ文字列
+     */
+    struct MessageText {
+        std::string str{};
+        int ref_count = 0;
+    };
+
+    /*!
+     * @brief 履歴の1行
+     */
+    struct MessageRecord {
+        uint32_t text_id = 0;
+        int count = 0;
+    };
+
+    std::deque<MessageText> texts{}; //!< 文字列の領域 (要素を追加しても既存の文字列の位置は変わらない)
+    std::vector<uint32_t> free_text_ids{}; //!< 再利用できる文字列の番号
+    std::unordered_map<std::string_view, uint32_t> text_ids{}; //!< 文字列から番号への索引
+    std::vector<MessageRecord> records{}; //!< 履歴のリングバッファ
+    size_t head = 0; //!< 最新の履歴の位置
+    size_t num_records = 0; //!< 保持している履歴の数
+
+    uint32_t intern(std::string_view str);
+    void release(uint32_t text_id);
+};
+
+MessageHistory message_history;
+
+/*!
+ * @brief 保持している履歴の数を返す
+ * @return 履歴の数
+ */
+int MessageHistory::size() const
+{
+    return static_cast<int>(this->num_records);
+}
 
-/** 同一メッセージの検索に使用するmapオブジェクト。
- * 同一メッセージがあるかどうかを検索し、ヒットしたらweak_ptrからshared_ptrを作成しメッセージを共有する。
- * message_historyのカスタムデリータの中で参照するので、message_historyより先に宣言しなければならない事に注意。
+/*!
+ * @brief 履歴のメッセージを返す
+ * @param age メッセージの世代 (0が最新)
+ * @return メッセージ. 繰り返されていれば「～ <xNN>」の形式
  */
-std::map<const std::string *, msg_wp, decltype(string_ptr_cmp)> message_map(string_ptr_cmp);
+std::string MessageHistory::get(int age) const
+{
+    const auto &record = this->records[(this->head + age) % this->records.size()];
+    std::string str = this->texts[record.text_id].str;
+    if (record.count > 1) {
+        str.append(format(" <x%d>", record.count));
+    }
 
-/** メッセージ履歴 */
-std::deque<msg_sp> message_history;
+    return str;
+}
 
-/**
- * @brief メッセージを保持する msg_sp オブジェクトを生成する
- *
- * @tparam T メッセージの型。std::string / std::string_view / const char* 等
+/*!
+ * @brief 最新の履歴が同じメッセージなら繰り返し回数を増やす
  * @param str メッセージ
- * @return 生成した msg_sp オブジェクト
+ * @return 纏めたならtrue
  */
-template <typename T>
-msg_sp make_message(T &&str)
+bool MessageHistory::add_repeat(std::string_view str)
 {
-    /** std::stringオブジェクトと同時にmessage_mapのエントリも削除するカスタムデリータ */
-    auto deleter = [](std::string *s) {
-        message_map.erase(s);
-        delete s;
-    };
+    if (this->num_records == 0) {
+        return false;
+    }
 
-    // 新たにメッセージを保持する msg_sp オブジェクトを生成し、検索用mapオブジェクトにも追加する
-    auto new_msg = msg_sp(new std::string(std::forward<T>(str)), std::move(deleter));
-    message_map.emplace(new_msg.get(), msg_wp(new_msg));
+    auto &record = this->records[this->head];
+    if ((record.count >= MAX_REPEAT_COUNT) || (this->texts[record.text_id].str != str)) {
+        return false;
+    }
 
-    return new_msg;
+    record.count++;
+    return true;
+}
+
+/*!
+ * @brief 履歴の先頭にメッセージを追加する
+ * @param str メッセージ
+ * @param count 繰り返し回数
+ * @details 履歴が一杯なら最も古いメッセージを捨てる
+ */
+void MessageHistory::push_front(std::string_view str, int count)
+{
+    if (this->records.empty()) {
+        this->records.resize(MESSAGE_MAX);
+    }
+
+    const auto text_id = this->intern(str);
+    this->head = (this->head + this->records.size() - 1) % this->records.size();
+    if (this->num_records == this->records.size()) {
+        this->release(this->records[this->head].text_id);
+    } else {
+        this->num_records++;
+    }
+
+    this->records[this->head] = { text_id, count };
+}
+
+/*!
+ * @brief 文字列を登録し、参照数を増やす
+ * @param str 文字列
+ * @return 文字列の番号. 登録済の文字列ならその番号
+ */
+uint32_t MessageHistory::intern(std::string_view str)
+{
+    if (const auto it = this->text_ids.find(str); it != this->text_ids.end()) {
+        this->texts[it->second].ref_count++;
+        return it->second;
+    }
+
+    uint32_t text_id;
+    if (this->free_text_ids.empty()) {
+        text_id = static_cast<uint32_t>(this->texts.size());
+        this->texts.emplace_back();
+    } else {
+        text_id = this->free_text_ids.back();
+        this->free_text_ids.pop_back();
+    }
+
+    auto &text = this->texts[text_id];
+    text.str = str;
+    text.ref_count = 1;
+    this->text_ids.emplace(text.str, text_id);
+    return text_id;
+}
+
+/*!
+ * @brief 文字列の参照数を減らし、参照されなくなったら領域を再利用に回す
+ * @param text_id 文字列の番号
+ */
+void MessageHistory::release(uint32_t text_id)
+{
+    auto &text = this->texts[text_id];
+    if (--text.ref_count > 0) {
+        return;
+    }
+
+    this->text_ids.erase(text.str);
+    text.str.clear();
+    this->free_text_ids.push_back(text_id);
+}
+
+/*!
+ * @brief メッセージ末尾の「 <xNN>」を取り除き、繰り返し回数を返す
+ * @param str メッセージ
+ * @return 繰り返し回数. 末尾に「 <xNN>」がなければ1
+ * @details セーブファイルから読み込んだメッセージは「～ <xNN>」の形式で保存されている
+ */
+int split_repeat_count(std::string_view &str)
+{
+    const auto pos = str.rfind(" <x");
+    if ((pos == std::string_view::npos) || (pos == 0) || !str.ends_with('>')) {
+        return 1;
+    }
+
+    const auto digits = str.substr(pos + 3, str.length() - pos - 4);
+    if (digits.empty() || (digits.length() > 4) || !std::all_of(digits.begin(), digits.end(), [](auto c) { return isdigit(c); })) {
+        return 1;
+    }
+
+    const auto count = std::stoi(std::string(digits));
+    if ((count < 1) || (count > MAX_REPEAT_COUNT)) {
+        return 1;
+    }
+
+    str = str.substr(0, pos);
+    return count;
 }
 }
 
@@ -78,26 +227,29 @@ int32_t message_num(void)
 /*!
  * @brief 過去のゲームメッセージを返す。 / Recall the "text" of a saved message
  * @param age メッセージの世代
- * @return メッセージの文字列ポインタ
+ * @return メッセージの文字列
  */
-concptr message_str(int age)
+std::string message_str(int age)
 {
     if ((age < 0) || (age >= message_num())) {
         return "";
     }
 
-    return message_history[age]->data();
+    return message_history.get(age);
 }
 
-static void message_add_aux(std::string str)
+/*!
+ * @brief メッセージを履歴に追加する
+ * @param str メッセージ
+ */
+static void message_add_aux(std::string_view str)
 {
-    std::string splitted;
-
     if (str.empty()) {
         return;
     }
 
     // MAIN_TERM_MIN_COLS桁を超えるメッセージはMAIN_TERM_MIN_COLS桁ずつ分割する
+    std::string_view splitted;
     if (str.length() > MAIN_TERM_MIN_COLS) {
         int n;
 #ifdef JP
@@ -126,61 +278,23 @@ static void message_add_aux(std::string str)
     }
 
     // 直前と同じメッセージの場合、「～ <xNN>」と表示する
-    if (!message_history.empty()) {
-        const char *t;
-        std::string_view last_message = *message_history.front();
-#ifdef JP
-        for (t = last_message.data(); *t && (*t != '<' || (*(t + 1) != 'x')); t++) {
-            if (iskanji(*t)) {
-                t++;
-            }
-        }
-#else
-        for (t = last_message.data(); *t && (*t != '<'); t++) {
-            ;
-        }
-#endif
-        int j = 1;
-        if (*t && t != last_message.data()) {
-            if (last_message.length() >= sizeof(" <xN>") - 1) {
-                last_message = last_message.substr(0, t - last_message.data() - 1);
-                j = atoi(t + 2);
-            }
+    if (message_history.add_repeat(str)) {
+        if (!now_message) {
+            now_message++;
         }
-
-        if (str == last_message && (j < 1000)) {
-            str = format("%s <x%d>", str.data(), j + 1);
-            message_history.pop_front();
-            if (!now_message) {
-                now_message++;
-            }
-        } else {
+    } else {
+        if (message_history.size() > 0) {
             /*流れた行の数を数えておく */
             num_more++;
             now_message++;
         }
-    }
-
-    msg_sp add_msg;
-
-    // メッセージ履歴から同一のメッセージを探す
-    if (const auto &it = message_map.find(&str); it != message_map.end()) {
-        // 同一のメッセージが見つかったならそのメッセージの msg_sp オブジェクトを複製
-        add_msg = it->second.lock();
-    } else {
-        // 見つからなかった場合は新たに msg_sp オブジェクトを作成
-        add_msg = make_message(std::move(str));
-    }
-
-    // メッセージ履歴に追加
-    message_history.push_front(std::move(add_msg));
 
-    if (message_history.size() == MESSAGE_MAX) {
-        message_history.pop_back();
+        const auto count = split_repeat_count(str);
+        message_history.push_front(str, count);
     }
 
     if (!splitted.empty()) {
-        message_add_aux(std::move(splitted));
+        message_add_aux(splitted);
     }
 }
 
@@ -190,7 +304,7 @@ static void message_add_aux(std::string str)
  */
 void message_add(std::string_view msg)
 {
-    message_add_aux(std::string(msg));
+    message_add_aux(msg);
 }
 
 bool is_msg_window_flowed(void)
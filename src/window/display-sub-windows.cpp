@@ -69,6 +69,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <util/object-sort.h>
 
 /*! サブウィンドウ表示用の ItemTester オブジェクト */
@@ -348,14 +349,14 @@ static void display_equipment(PlayerType *player_ptr, const ItemTester &item_tes
         term_erase(cur_col, cur_row, 255);
         term_putstr(0, cur_row, cur_col, TERM_WHITE, tmp_val);
 
-        std::string item_name;
+        std::string_view item_name;
         auto is_two_handed = (i == INVEN_MAIN_HAND) && can_attack_with_sub_hand(player_ptr);
         is_two_handed |= (i == INVEN_SUB_HAND) && can_attack_with_main_hand(player_ptr);
         if (is_two_handed && has_two_handed_weapons(player_ptr)) {
             item_name = _("(武器を両手持ち)", "(wielding with two-hands)");
             attr = TERM_WHITE;
         } else {
-            item_name = describe_flavor(player_ptr, o_ptr, 0);
+            item_name = describe_flavor_cached(player_ptr, o_ptr, 0);
             attr = tval_to_attr[enum2i(o_ptr->bi_key.tval()) % 128];
         }
 
@@ -634,7 +635,7 @@ static void display_floor_item_list(PlayerType *player_ptr, const int y, const i
         if (is_hallucinated) {
             term_addstr(-1, TERM_WHITE, _("何か奇妙な物", "something strange"));
         } else {
-            const auto item_name = describe_flavor(player_ptr, o_ptr, 0);
+            const auto &item_name = describe_flavor_cached(player_ptr, o_ptr, 0);
             TERM_COLOR attr = tval_to_attr[enum2i(tval) % 128];
             term_addstr(-1, attr, item_name);
         }
@@ -669,29 +670,9 @@ static void display_found_item_list(PlayerType *player_ptr)
         return;
     }
 
-    auto *floor_ptr = player_ptr->current_floor_ptr;
-
-    // 所持品一覧と同じ順にソートする
-    // あらかじめfloor_ptr->o_list から↓項目を取り除く
-    // bi_idが0
-    // OM_FOUNDフラグが立っていない
-    // ItemKindTypeがGOLD
-    std::vector<ItemEntity *> found_item_list;
-    for (auto &item : floor_ptr->o_list) {
-        const auto is_item_to_display =
-            item.is_valid() && (item.number > 0) &&
-            item.marked.has(OmType::FOUND) && (item.bi_key.tval() != ItemKindType::GOLD);
-
-        if (is_item_to_display) {
-            found_item_list.push_back(&item);
-        }
-    }
-
-    std::sort(
-        found_item_list.begin(), found_item_list.end(),
-        [player_ptr](ItemEntity *left, ItemEntity *right) -> bool {
-            return object_sort_comp(player_ptr, left, left->get_price(), right);
-        });
+    // 所持品一覧と同じ順に並べた発見済みアイテムの索引を辿る
+    auto &floor = *player_ptr->current_floor_ptr;
+    const auto &found_item_indices = floor.found_item_index.get_sorted_indices(player_ptr);
 
     term_clear();
     term_gotoxy(0, 0);
@@ -701,7 +682,9 @@ static void display_found_item_list(PlayerType *player_ptr)
 
     // 発見済みのアイテムを表示
     TERM_LEN term_y = 1;
-    for (auto item : found_item_list) {
+    for (const auto o_idx : found_item_indices) {
+        const auto *item = &floor.o_list[o_idx];
+
         // 途中で行数が足りなくなったら終了。
         if (term_y >= term_h) {
             break;
@@ -715,7 +698,7 @@ static void display_found_item_list(PlayerType *player_ptr)
         const auto color_code_for_symbol = item->get_color();
         term_addstr(-1, color_code_for_symbol, symbol);
 
-        const auto item_name = describe_flavor(player_ptr, item, 0);
+        const auto &item_name = describe_flavor_cached(player_ptr, item, 0);
         const auto color_code_for_item = tval_to_attr[enum2i(item->bi_key.tval()) % 128];
         term_addstr(-1, color_code_for_item, item_name);
 
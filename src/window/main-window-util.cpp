@@ -6,6 +6,7 @@
 #include "game-option/map-screen-options.h"
 #include "game-option/special-options.h"
 #include "grid/grid.h"
+#include "grid/lite-spot-queue.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-indice-types.h"
 #include "player/player-status.h"
@@ -13,12 +14,14 @@
 #include "system/item-entity.h"
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
+#include "system/redrawing-flags-updater.h"
 #include "term/gameterm.h"
 #include "term/screen-processor.h"
 #include "term/term-color-types.h"
 #include "timed-effect/player-hallucination.h"
 #include "timed-effect/timed-effects.h"
 #include "view/display-map.h"
+#include "window/map-overview.h"
 #include "world/world.h"
 #include <string>
 #include <string_view>
@@ -82,6 +85,7 @@ void print_map(PlayerType *player_ptr)
 
     (void)term_set_cursor(0);
 
+    LiteSpotQueue::get_instance().clear();
     auto *floor_ptr = player_ptr->current_floor_ptr;
     POSITION xmin = (0 < panel_col_min) ? panel_col_min : 0;
     POSITION xmax = (floor_ptr->width - 1 > panel_col_max) ? panel_col_max : floor_ptr->width - 1;
@@ -119,6 +123,9 @@ void print_map(PlayerType *player_ptr)
 
     lite_spot(player_ptr, player_ptr->y, player_ptr->x);
     (void)term_set_cursor(v);
+
+    MapOverview::get_instance().invalidate();
+    RedrawingFlagsUpdater::get_instance().set_flag(SubWindowRedrawingFlag::OVERHEAD);
 }
 
 /*!
@@ -170,13 +177,6 @@ static void display_shortened_item_name(PlayerType *player_ptr, ItemEntity *o_pt
  */
 void display_map(PlayerType *player_ptr, int *cy, int *cx)
 {
-    int i, j, x, y;
-
-    TERM_COLOR ta;
-    char tc;
-
-    byte tp;
-
     bool old_view_special_lite = view_special_lite;
     bool old_view_granite_lite = view_granite_lite;
 
@@ -195,86 +195,19 @@ void display_map(PlayerType *player_ptr, int *cy, int *cx)
     view_special_lite = false;
     view_granite_lite = false;
 
-    using std::vector;
-    vector<vector<TERM_COLOR>> ma(hgt + 2, vector<TERM_COLOR>(wid + 2, TERM_WHITE));
-    vector<vector<char>> mc(hgt + 2, vector<char>(wid + 2, ' '));
-    vector<vector<byte>> mp(hgt + 2, vector<byte>(wid + 2, 0));
-    vector<vector<int>> match_autopick_yx(hgt + 2, vector<int>(wid + 2, -1));
-    vector<vector<ItemEntity *>> object_autopick_yx(hgt + 2, vector<ItemEntity *>(wid + 2, nullptr));
-
-    vector<vector<TERM_COLOR>> bigma(floor_ptr->height + 2, vector<TERM_COLOR>(floor_ptr->width + 2, TERM_WHITE));
-    vector<vector<char>> bigmc(floor_ptr->height + 2, vector<char>(floor_ptr->width + 2, ' '));
-    vector<vector<byte>> bigmp(floor_ptr->height + 2, vector<byte>(floor_ptr->width + 2, 0));
-
-    for (i = 0; i < floor_ptr->width; ++i) {
-        for (j = 0; j < floor_ptr->height; ++j) {
-            x = i / xrat + 1;
-            y = j / yrat + 1;
-
-            match_autopick = -1;
-            autopick_obj = nullptr;
-            feat_priority = -1;
-            map_info(player_ptr, j, i, &ta, &tc, &ta, &tc);
-            tp = (byte)feat_priority;
-            if (match_autopick != -1 && (match_autopick_yx[y][x] == -1 || match_autopick_yx[y][x] > match_autopick)) {
-                match_autopick_yx[y][x] = match_autopick;
-                object_autopick_yx[y][x] = autopick_obj;
-                tp = 0x7f;
-            }
-
-            bigmc[j + 1][i + 1] = tc;
-            bigma[j + 1][i + 1] = ta;
-            bigmp[j + 1][i + 1] = tp;
-        }
-    }
-
-    for (j = 0; j < floor_ptr->height; ++j) {
-        for (i = 0; i < floor_ptr->width; ++i) {
-            x = i / xrat + 1;
-            y = j / yrat + 1;
-
-            tc = bigmc[j + 1][i + 1];
-            ta = bigma[j + 1][i + 1];
-            tp = bigmp[j + 1][i + 1];
-            if (mp[y][x] == tp) {
-                int t;
-                int cnt = 0;
-
-                for (t = 0; t < 8; t++) {
-                    if (tc == bigmc[j + 1 + ddy_cdd[t]][i + 1 + ddx_cdd[t]] && ta == bigma[j + 1 + ddy_cdd[t]][i + 1 + ddx_cdd[t]]) {
-                        cnt++;
-                    }
-                }
-                if (cnt <= 4) {
-                    tp++;
-                }
-            }
-
-            if (mp[y][x] < tp) {
-                mc[y][x] = tc;
-                ma[y][x] = ta;
-                mp[y][x] = tp;
-            }
-        }
+    /* 自動拾いの強調表示や幻覚中の表示は保持せず、その都度計算し直す */
+    auto &overview = MapOverview::get_instance();
+    const auto is_volatile = (display_autopick != 0) || player_ptr->effects()->hallucination()->is_hallucinated();
+    if (is_volatile) {
+        overview.invalidate();
     }
 
-    x = wid + 1;
-    y = hgt + 1;
-
-    mc[0][0] = mc[0][x] = mc[y][0] = mc[y][x] = '+';
-    for (x = 1; x <= wid; x++) {
-        mc[0][x] = mc[y][x] = '-';
-    }
-
-    for (y = 1; y <= hgt; y++) {
-        mc[y][0] = mc[y][x] = '|';
-    }
-
-    for (y = 0; y < hgt + 2; ++y) {
+    overview.update(player_ptr, wid, hgt);
+    for (auto y = 0; y < hgt + 2; ++y) {
         term_gotoxy(COL_MAP, y);
-        for (x = 0; x < wid + 2; ++x) {
-            ta = ma[y][x];
-            tc = mc[y][x];
+        for (auto x = 0; x < wid + 2; ++x) {
+            auto ta = overview.get_attr(y, x);
+            const auto tc = overview.get_char(y, x);
             if (!use_graphics) {
                 if (w_ptr->timewalk_m_idx) {
                     ta = TERM_DARK;
@@ -289,12 +222,13 @@ void display_map(PlayerType *player_ptr, int *cy, int *cx)
         }
     }
 
-    for (y = 1; y < hgt + 1; ++y) {
+    for (auto y = 1; y < hgt + 1; ++y) {
         match_autopick = -1;
-        for (x = 1; x <= wid; x++) {
-            if (match_autopick_yx[y][x] != -1 && (match_autopick > match_autopick_yx[y][x] || match_autopick == -1)) {
-                match_autopick = match_autopick_yx[y][x];
-                autopick_obj = object_autopick_yx[y][x];
+        for (auto x = 1; x <= wid; x++) {
+            const auto match = overview.get_match_autopick(y, x);
+            if (match != -1 && (match_autopick > match || match_autopick == -1)) {
+                match_autopick = match;
+                autopick_obj = overview.get_autopick_obj(y, x);
             }
         }
 
@@ -304,6 +238,10 @@ void display_map(PlayerType *player_ptr, int *cy, int *cx)
         }
     }
 
+    if (is_volatile) {
+        overview.invalidate();
+    }
+
     (*cy) = player_ptr->y / yrat + 1 + ROW_MAP;
     if (!use_bigtile) {
         (*cx) = player_ptr->x / xrat + 1 + COL_MAP;
@@ -0,0 +1,298 @@
+﻿/*!
+ * @brief 縮小マップの描画内容の管理
+ */
+
+#include "window/map-overview.h"
+#include "floor/geometry.h"
+#include "system/floor-type-definition.h"
+#include "system/player-type-definition.h"
+#include "term/term-color-types.h"
+#include "view/display-map.h"
+#include "window/main-window-util.h"
+#include <algorithm>
+
+MapOverview MapOverview::instance{};
+
+MapOverview &MapOverview::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 保持している描画内容を破棄し、次回の更新で全て計算し直させる
+ */
+void MapOverview::invalidate()
+{
+    this->is_valid = false;
+}
+
+/*!
+ * @brief グリッドの表示が変わり得ることを記録する
+ * @param y グリッドのy座標
+ * @param x グリッドのx座標
+ */
+void MapOverview::set_dirty(POSITION y, POSITION x)
+{
+    if (!this->is_valid || (y < 0) || (y >= this->floor_height) || (x < 0) || (x >= this->floor_width)) {
+        return;
+    }
+
+    const auto idx = this->big_index(y, x);
+    if (this->big_dirty[idx]) {
+        return;
+    }
+
+    this->big_dirty[idx] = true;
+    this->dirty_grids.push_back(idx);
+}
+
+/*!
+ * @brief 縮小マップの描画内容を最新にする
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param wid 縮小マップの幅 (枠線抜)
+ * @param hgt 縮小マップの高さ (枠線抜)
+ * @details 階の大きさや縮小マップの大きさが変わった時、及び無効化された時は全て計算し直す.
+ * それ以外は表示が変わり得るグリッドとそれに隣接するグリッドを含む区画だけを計算し直す.
+ */
+void MapOverview::update(PlayerType *player_ptr, TERM_LEN wid, TERM_LEN hgt)
+{
+    const auto *floor_ptr = player_ptr->current_floor_ptr;
+    const auto should_rebuild_grids = !this->is_valid || (this->floor_height != floor_ptr->height) || (this->floor_width != floor_ptr->width);
+    if (should_rebuild_grids) {
+        this->floor_height = floor_ptr->height;
+        this->floor_width = floor_ptr->width;
+        const auto size = static_cast<size_t>(this->floor_height + 2) * (this->floor_width + 2);
+        this->bigma.assign(size, TERM_WHITE);
+        this->bigmc.assign(size, ' ');
+        this->bigmp.assign(size, 0);
+        this->bigmp_picked.assign(size, 0);
+        this->big_match_autopick.assign(size, -1);
+        this->big_autopick_obj.assign(size, nullptr);
+        this->big_dirty.assign(size, false);
+        this->dirty_grids.clear();
+    }
+
+    const auto new_yrat = (this->floor_height + hgt - 1) / hgt;
+    const auto new_xrat = (this->floor_width + wid - 1) / wid;
+    const auto should_rebuild_blocks = should_rebuild_grids || (this->map_height != hgt) || (this->map_width != wid) || (this->yrat != new_yrat) || (this->xrat != new_xrat);
+    if (should_rebuild_blocks) {
+        this->map_height = hgt;
+        this->map_width = wid;
+        this->yrat = new_yrat;
+        this->xrat = new_xrat;
+        const auto size = static_cast<size_t>(hgt + 2) * (wid + 2);
+        this->ma.assign(size, TERM_WHITE);
+        this->mc.assign(size, ' ');
+        this->mp.assign(size, 0);
+        this->match_autopick_yx.assign(size, -1);
+        this->object_autopick_yx.assign(size, nullptr);
+        this->dirty_blocks.assign(size, false);
+        this->dirty_block_list.clear();
+
+        const auto x = wid + 1;
+        const auto y = hgt + 1;
+        this->mc[this->block_index(0, 0)] = '+';
+        this->mc[this->block_index(0, x)] = '+';
+        this->mc[this->block_index(y, 0)] = '+';
+        this->mc[this->block_index(y, x)] = '+';
+        for (auto i = 1; i <= wid; i++) {
+            this->mc[this->block_index(0, i)] = '-';
+            this->mc[this->block_index(y, i)] = '-';
+        }
+
+        for (auto j = 1; j <= hgt; j++) {
+            this->mc[this->block_index(j, 0)] = '|';
+            this->mc[this->block_index(j, x)] = '|';
+        }
+    }
+
+    if (should_rebuild_grids) {
+        for (POSITION y = 0; y < this->floor_height; y++) {
+            for (POSITION x = 0; x < this->floor_width; x++) {
+                this->update_grid(player_ptr, y, x);
+            }
+        }
+    } else {
+        for (const auto idx : this->dirty_grids) {
+            this->big_dirty[idx] = false;
+            const auto y = idx / (this->floor_width + 2) - 1;
+            const auto x = idx % (this->floor_width + 2) - 1;
+            this->update_grid(player_ptr, y, x);
+            if (!should_rebuild_blocks) {
+                this->set_blocks_dirty_around(y, x);
+            }
+        }
+
+        this->dirty_grids.clear();
+    }
+
+    if (should_rebuild_blocks) {
+        for (auto y = 1; y <= (this->floor_height - 1) / this->yrat + 1; y++) {
+            for (auto x = 1; x <= (this->floor_width - 1) / this->xrat + 1; x++) {
+                this->update_block(y, x);
+            }
+        }
+    } else {
+        for (const auto idx : this->dirty_block_list) {
+            this->dirty_blocks[idx] = false;
+            this->update_block(idx / (this->map_width + 2), idx % (this->map_width + 2));
+        }
+    }
+
+    this->dirty_block_list.clear();
+    this->is_valid = true;
+}
+
+TERM_COLOR MapOverview::get_attr(TERM_LEN y, TERM_LEN x) const
+{
+    return this->ma[this->block_index(y, x)];
+}
+
+char MapOverview::get_char(TERM_LEN y, TERM_LEN x) const
+{
+    return this->mc[this->block_index(y, x)];
+}
+
+int MapOverview::get_match_autopick(TERM_LEN y, TERM_LEN x) const
+{
+    return this->match_autopick_yx[this->block_index(y, x)];
+}
+
+ItemEntity *MapOverview::get_autopick_obj(TERM_LEN y, TERM_LEN x) const
+{
+    return this->object_autopick_yx[this->block_index(y, x)];
+}
+
+int MapOverview::big_index(POSITION y, POSITION x) const
+{
+    return (y + 1) * (this->floor_width + 2) + (x + 1);
+}
+
+int MapOverview::block_index(TERM_LEN y, TERM_LEN x) const
+{
+    return y * (this->map_width + 2) + x;
+}
+
+void MapOverview::set_block_dirty(TERM_LEN y, TERM_LEN x)
+{
+    const auto idx = this->block_index(y, x);
+    if (this->dirty_blocks[idx]) {
+        return;
+    }
+
+    this->dirty_blocks[idx] = true;
+    this->dirty_block_list.push_back(idx);
+}
+
+/*!
+ * @brief グリッドの表示内容を計算し直す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param y グリッドのy座標
+ * @param x グリッドのx座標
+ */
+void MapOverview::update_grid(PlayerType *player_ptr, POSITION y, POSITION x)
+{
+    TERM_COLOR ta;
+    char tc;
+    match_autopick = -1;
+    autopick_obj = nullptr;
+    feat_priority = -1;
+    map_info(player_ptr, y, x, &ta, &tc, &ta, &tc);
+
+    const auto idx = this->big_index(y, x);
+    this->bigma[idx] = ta;
+    this->bigmc[idx] = tc;
+    this->bigmp[idx] = static_cast<byte>(feat_priority);
+    this->big_match_autopick[idx] = match_autopick;
+    this->big_autopick_obj[idx] = autopick_obj;
+}
+
+/*!
+ * @brief グリッドの表示内容を参照する区画を計算し直させる
+ * @param y グリッドのy座標
+ * @param x グリッドのx座標
+ * @details 隣接グリッドの表示内容は周囲の区画の優先度判定にも使われるため、
+ * 周囲8グリッドを含む区画も対象にする.
+ */
+void MapOverview::set_blocks_dirty_around(POSITION y, POSITION x)
+{
+    for (auto dy = -1; dy <= 1; dy++) {
+        for (auto dx = -1; dx <= 1; dx++) {
+            const auto ny = y + dy;
+            const auto nx = x + dx;
+            if ((ny < 0) || (ny >= this->floor_height) || (nx < 0) || (nx >= this->floor_width)) {
+                continue;
+            }
+
+            this->set_block_dirty(ny / this->yrat + 1, nx / this->xrat + 1);
+        }
+    }
+}
+
+/*!
+ * @brief 縮小マップの区画の表示内容を計算し直す
+ * @param y 区画のy座標
+ * @param x 区画のx座標
+ * @details 区画内のグリッドを走査する順序は、同じ優先度のグリッドからの選び方に影響するため変えないこと.
+ */
+void MapOverview::update_block(TERM_LEN y, TERM_LEN x)
+{
+    const auto block_idx = this->block_index(y, x);
+    auto &block_ma = this->ma[block_idx];
+    auto &block_mc = this->mc[block_idx];
+    auto &block_mp = this->mp[block_idx];
+    auto &block_match = this->match_autopick_yx[block_idx];
+    block_ma = TERM_WHITE;
+    block_mc = ' ';
+    block_mp = 0;
+    block_match = -1;
+    this->object_autopick_yx[block_idx] = nullptr;
+
+    const auto j_min = (y - 1) * this->yrat;
+    const auto j_max = std::min<int>(y * this->yrat, this->floor_height);
+    const auto i_min = (x - 1) * this->xrat;
+    const auto i_max = std::min<int>(x * this->xrat, this->floor_width);
+    for (auto i = i_min; i < i_max; i++) {
+        for (auto j = j_min; j < j_max; j++) {
+            const auto idx = this->big_index(j, i);
+            auto tp = this->bigmp[idx];
+            const auto match = this->big_match_autopick[idx];
+            if ((match != -1) && ((block_match == -1) || (block_match > match))) {
+                block_match = match;
+                this->object_autopick_yx[block_idx] = this->big_autopick_obj[idx];
+                tp = 0x7f;
+            }
+
+            this->bigmp_picked[idx] = tp;
+        }
+    }
+
+    const auto stride = this->floor_width + 2;
+    for (auto j = j_min; j < j_max; j++) {
+        for (auto i = i_min; i < i_max; i++) {
+            const auto idx = this->big_index(j, i);
+            const auto tc = this->bigmc[idx];
+            const auto ta = this->bigma[idx];
+            auto tp = this->bigmp_picked[idx];
+            if (block_mp == tp) {
+                auto cnt = 0;
+                for (auto t = 0; t < 8; t++) {
+                    const auto neighbor = idx + ddy_cdd[t] * stride + ddx_cdd[t];
+                    if ((tc == this->bigmc[neighbor]) && (ta == this->bigma[neighbor])) {
+                        cnt++;
+                    }
+                }
+
+                if (cnt <= 4) {
+                    tp++;
+                }
+            }
+
+            if (block_mp < tp) {
+                block_mc = tc;
+                block_ma = ta;
+                block_mp = tp;
+            }
+        }
+    }
+}
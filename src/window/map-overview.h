@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <vector>
+
+class ItemEntity;
+class PlayerType;
+
+/*!
+ * @brief 縮小マップの描画内容
+ * @details
+ * 階の各グリッドの表示内容と、それを縮小した各区画の表示内容を保持する.
+ * lite_spot() で表示が変わり得るグリッドを記録しておき、
+ * 次の更新ではそのグリッドとそれを含む区画だけを計算し直す.
+ * マップ全体を描き直す時は invalidate() を呼ぶこと.
+ */
+class MapOverview {
+public:
+    MapOverview(const MapOverview &) = delete;
+    MapOverview(MapOverview &&) = delete;
+    MapOverview &operator=(const MapOverview &) = delete;
+    MapOverview &operator=(MapOverview &&) = delete;
+    ~MapOverview() = default;
+
+    static MapOverview &get_instance();
+
+    void invalidate();
+    void set_dirty(POSITION y, POSITION x);
+    void update(PlayerType *player_ptr, TERM_LEN wid, TERM_LEN hgt);
+
+    TERM_COLOR get_attr(TERM_LEN y, TERM_LEN x) const;
+    char get_char(TERM_LEN y, TERM_LEN x) const;
+    int get_match_autopick(TERM_LEN y, TERM_LEN x) const;
+    ItemEntity *get_autopick_obj(TERM_LEN y, TERM_LEN x) const;
+
+private:
+    MapOverview() = default;
+
+    static MapOverview instance;
+
+    bool is_valid = false;
+    POSITION floor_height = 0;
+    POSITION floor_width = 0;
+    TERM_LEN map_height = 0;
+    TERM_LEN map_width = 0;
+    int yrat = 0;
+    int xrat = 0;
+
+    /* 階のグリッド毎の情報 (周囲1グリッドの枠付き) */
+    std::vector<TERM_COLOR> bigma{};
+    std::vector<char> bigmc{};
+    std::vector<byte> bigmp{}; //!< 地形の優先度
+    std::vector<byte> bigmp_picked{}; //!< 自動拾いの一致を反映した優先度
+    std::vector<int> big_match_autopick{};
+    std::vector<ItemEntity *> big_autopick_obj{};
+    std::vector<bool> big_dirty{};
+    std::vector<int> dirty_grids{};
+
+    /* 縮小マップの区画毎の情報 (枠付き) */
+    std::vector<TERM_COLOR> ma{};
+    std::vector<char> mc{};
+    std::vector<byte> mp{};
+    std::vector<int> match_autopick_yx{};
+    std::vector<ItemEntity *> object_autopick_yx{};
+    std::vector<bool> dirty_blocks{};
+    std::vector<int> dirty_block_list{};
+
+    int big_index(POSITION y, POSITION x) const;
+    int block_index(TERM_LEN y, TERM_LEN x) const;
+    void set_block_dirty(TERM_LEN y, TERM_LEN x);
+    void update_grid(PlayerType *player_ptr, POSITION y, POSITION x);
+    void set_blocks_dirty_around(POSITION y, POSITION x);
+    void update_block(TERM_LEN y, TERM_LEN x);
+};
@@ -10,6 +10,7 @@
 #include "term/z-form.h"
 #include "util/angband-files.h"
 #include "util/bit-flags-calculator.h"
+#include "util/enum-converter.h"
 #include "util/sort.h"
 #include "util/string-processor.h"
 #include "view/display-lore.h"
@@ -75,7 +76,6 @@ static concptr attr_to_text(MonsterRaceInfo *r_ptr)
 
 SpoilerOutputResultType spoil_mon_desc(concptr fname, std::function<bool(const MonsterRaceInfo *)> filter_monster)
 {
-    PlayerType dummy;
     uint16_t why = 2;
     const auto &path = path_build(ANGBAND_DIR_USER, fname);
     spoiler_file = angband_fopen(path, FileOpenMode::WRITE);
@@ -99,7 +99,7 @@ SpoilerOutputResultType spoil_mon_desc(concptr fname, std::function<bool(const M
         }
     }
 
-    ang_sort(&dummy, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    sort_monrace_ids(who, why);
     for (auto r_idx : who) {
         auto *r_ptr = &monraces_info[r_idx];
         if (filter_monster && !filter_monster(r_ptr)) {
@@ -166,7 +166,6 @@ static void roff_func(TERM_COLOR attr, std::string_view str)
  */
 SpoilerOutputResultType spoil_mon_info(concptr fname)
 {
-    PlayerType dummy;
     const auto &path = path_build(ANGBAND_DIR_USER, fname);
     spoiler_file = angband_fopen(path, FileOpenMode::WRITE);
     if (!spoiler_file) {
@@ -184,7 +183,7 @@ SpoilerOutputResultType spoil_mon_info(concptr fname)
     }
 
     uint16_t why = 2;
-    ang_sort(&dummy, who.data(), &why, who.size(), ang_sort_comp_hook, ang_sort_swap_hook);
+    sort_monrace_ids(who, why);
     for (auto r_idx : who) {
         auto *r_ptr = &monraces_info[r_idx];
         if (r_ptr->kind_flags.has(MonsterKindType::UNIQUE)) {
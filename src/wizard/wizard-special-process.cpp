@@ -795,6 +795,21 @@ void wiz_dump_options(void)
     msg_format(_("オプションbit使用状況をファイル %s に書き出しました。", "Option bits usage dump saved to file %s."), filename.data());
 }
 
+/*!
+ * @brief 現在のフロアの視線・射線判定キャッシュの統計を表示する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ */
+void wiz_show_line_of_sight_cache_stats(PlayerType *player_ptr)
+{
+    const auto &cache = player_ptr->current_floor_ptr->line_of_sight_cache;
+    const auto hit_count = static_cast<unsigned long long>(cache.get_hit_count());
+    const auto miss_count = static_cast<unsigned long long>(cache.get_miss_count());
+    const auto total = hit_count + miss_count;
+    const auto hit_rate = (total > 0) ? (hit_count * 100 / total) : 0ULL;
+    msg_format(_("視線判定キャッシュ: ヒット %llu 回, ミス %llu 回 (ヒット率 %llu%%)", "Line of sight cache: %llu hits, %llu misses (%llu%% hit rate)"),
+        hit_count, miss_count, hit_rate);
+}
+
 /*!
  * @brief プレイ日数を変更する / Set gametime.
  * @return 実際に変更を行ったらTRUEを返す
@@ -14,6 +14,7 @@ void wiz_reset_race(PlayerType *player_ptr);
 void wiz_reset_class(PlayerType *player_ptr);
 void wiz_reset_realms(PlayerType *player_ptr);
 void wiz_dump_options(void);
+void wiz_show_line_of_sight_cache_stats(PlayerType *player_ptr);
 void set_gametime(void);
 void wiz_zap_surrounding_monsters(PlayerType *player_ptr);
 void wiz_zap_floor_monsters(PlayerType *player_ptr);
@@ -21,17 +21,21 @@
  * @details
  * This routine should almost never fail, but in case it does,
  * we must be sure to handle "failure" of this routine.
+ * 再利用する空きは使用中アイテムの添字集合から探すため、配列全体を走査せずに済む.
  */
 OBJECT_IDX o_pop(FloorType *floor_ptr)
 {
+    auto &live_indices = floor_ptr->live_object_indices;
     if (floor_ptr->o_max < w_ptr->max_o_idx) {
         OBJECT_IDX i = floor_ptr->o_max;
         floor_ptr->o_max++;
         floor_ptr->o_cnt++;
+        live_indices.set(i);
         return i;
     }
 
-    for (OBJECT_IDX i = 1; i < floor_ptr->o_max; i++) {
+    for (auto i = live_indices.find_next_unset(1); i < floor_ptr->o_max; i = live_indices.find_next_unset(i + 1)) {
+        live_indices.set(i);
         if (floor_ptr->o_list[i].is_valid()) {
             continue;
         }
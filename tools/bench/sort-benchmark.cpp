@@ -0,0 +1,224 @@
+﻿/*!
+ * @file sort-benchmark.cpp
+ * @brief 旧 ang_sort() と sort_by_key() の速度比較
+ * @details
+ * ゲーム本体とは独立した計測用プログラム. ビルドには含めない.
+ * リポジトリの最上位ディレクトリで以下のようにビルドして実行する.
+ *   g++ -std=c++20 -O2 -I src tools/bench/sort-benchmark.cpp -o sort-benchmark && ./sort-benchmark
+ * 旧実装はゲームのデータ構造に依存しないよう、比較・交換関数をここに書き写してある.
+ */
+
+#include "util/sort.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*!
+ * @brief 計測の基準点 (プレイヤーの座標の代わり)
+ */
+struct Origin {
+    int y;
+    int x;
+};
+
+using AngSortComp = bool (*)(const Origin *, vptr, vptr, int, int);
+using AngSortSwap = void (*)(const Origin *, vptr, vptr, int, int);
+
+/*!
+ * @brief 旧 exe_ang_sort() の写し
+ */
+void exe_ang_sort(const Origin *origin, vptr u, vptr v, int p, int q, AngSortComp ang_sort_comp, AngSortSwap ang_sort_swap)
+{
+    if (p >= q) {
+        return;
+    }
+
+    int z = p;
+    int a = p;
+    int b = q;
+    while (true) {
+        while (!(*ang_sort_comp)(origin, u, v, b, z)) {
+            b--;
+        }
+
+        while (!(*ang_sort_comp)(origin, u, v, z, a)) {
+            a++;
+        }
+
+        if (a >= b) {
+            break;
+        }
+
+        (*ang_sort_swap)(origin, u, v, a, b);
+        a++, b--;
+    }
+
+    exe_ang_sort(origin, u, v, p, b, ang_sort_comp, ang_sort_swap);
+    exe_ang_sort(origin, u, v, b + 1, q, ang_sort_comp, ang_sort_swap);
+}
+
+/*!
+ * @brief 基準点からの距離の近似値 (2倍値) を返す
+ */
+int calc_double_distance(const Origin *origin, int y, int x)
+{
+    const auto kx = std::abs(x - origin->x);
+    const auto ky = std::abs(y - origin->y);
+    return (kx > ky) ? (kx + kx + ky) : (ky + ky + kx);
+}
+
+/*!
+ * @brief 旧 ang_sort_comp_distance() の写し
+ */
+bool ang_sort_comp_distance(const Origin *origin, vptr u, vptr v, int a, int b)
+{
+    const auto *x = static_cast<int *>(u);
+    const auto *y = static_cast<int *>(v);
+    return calc_double_distance(origin, y[a], x[a]) <= calc_double_distance(origin, y[b], x[b]);
+}
+
+/*!
+ * @brief 旧 ang_sort_swap_position() の写し
+ */
+void ang_sort_swap_position(const Origin *, vptr u, vptr v, int a, int b)
+{
+    auto *x = static_cast<int *>(u);
+    auto *y = static_cast<int *>(v);
+    std::swap(x[a], x[b]);
+    std::swap(y[a], y[b]);
+}
+
+/*!
+ * @brief 種族番号毎のレベル (monraces_info の代わり)
+ */
+std::map<short, int> levels;
+
+/*!
+ * @brief 旧 ang_sort_comp_hook() (レベル順) の写し
+ */
+bool ang_sort_comp_level(const Origin *, vptr u, vptr, int a, int b)
+{
+    const auto *ids = static_cast<short *>(u);
+    const auto z1 = levels[ids[a]];
+    const auto z2 = levels[ids[b]];
+    if (z1 < z2) {
+        return true;
+    }
+
+    if (z1 > z2) {
+        return false;
+    }
+
+    return ids[a] <= ids[b];
+}
+
+/*!
+ * @brief 旧 ang_sort_swap_hook() の写し
+ */
+void ang_sort_swap_id(const Origin *, vptr u, vptr, int a, int b)
+{
+    auto *ids = static_cast<short *>(u);
+    std::swap(ids[a], ids[b]);
+}
+
+/*!
+ * @brief 処理時間をミリ秒で計測する
+ */
+template <typename Func>
+double measure(Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+ * @brief 座標を基準点からの距離順に並べ替える速度を比較する
+ */
+void bench_distance(std::mt19937 &rng)
+{
+    const Origin origin{ 33, 99 };
+    for (const auto num : { 1000, 10000, 100000 }) {
+        std::vector<int> ys(num);
+        std::vector<int> xs(num);
+        for (auto i = 0; i < num; i++) {
+            ys[i] = rng() % 66;
+            xs[i] = rng() % 198;
+        }
+
+        auto old_ys = ys;
+        auto old_xs = xs;
+        const auto old_time = measure([&] { exe_ang_sort(&origin, old_xs.data(), old_ys.data(), 0, num - 1, ang_sort_comp_distance, ang_sort_swap_position); });
+
+        auto new_ys = ys;
+        auto new_xs = xs;
+        const auto new_time = measure([&] {
+            std::vector<std::pair<int, int>> positions;
+            positions.reserve(num);
+            for (auto i = 0; i < num; i++) {
+                positions.emplace_back(new_ys[i], new_xs[i]);
+            }
+
+            sort_by_key(positions.begin(), positions.end(), [&origin](const auto &pos) { return calc_double_distance(&origin, pos.first, pos.second); });
+            for (auto i = 0; i < num; i++) {
+                new_ys[i] = positions[i].first;
+                new_xs[i] = positions[i].second;
+            }
+        });
+
+        printf("distance   n=%6d      ang_sort %8.2f ms  sort_by_key %8.2f ms  x%.1f\n", num, old_time, new_time, old_time / new_time);
+    }
+}
+
+/*!
+ * @brief 種族番号をレベル順に並べ替える速度を比較し、結果が旧実装と一致するか確かめる
+ * @return 結果が一致したか
+ */
+bool bench_level(std::mt19937 &rng)
+{
+    constexpr auto num = 1200;
+    constexpr auto repeat = 100;
+    for (short i = 0; i < num; i++) {
+        levels[i] = rng() % 100;
+    }
+
+    std::vector<short> ids(num);
+    for (short i = 0; i < num; i++) {
+        ids[i] = i;
+    }
+
+    std::shuffle(ids.begin(), ids.end(), rng);
+    auto old_time = 0.0;
+    auto new_time = 0.0;
+    for (auto i = 0; i < repeat; i++) {
+        auto old_ids = ids;
+        auto new_ids = ids;
+        old_time += measure([&] { exe_ang_sort(nullptr, old_ids.data(), nullptr, 0, num - 1, ang_sort_comp_level, ang_sort_swap_id); });
+        new_time += measure([&] { sort_by_key(new_ids.begin(), new_ids.end(), [](short id) { return std::make_pair(levels[id], id); }); });
+        if (old_ids != new_ids) {
+            return false;
+        }
+    }
+
+    printf("level      n=%6d x%d ang_sort %8.2f ms  sort_by_key %8.2f ms  x%.1f\n", num, repeat, old_time, new_time, old_time / new_time);
+    return true;
+}
+
+}
+
+int main()
+{
+    std::mt19937 rng(1);
+    bench_distance(rng);
+    if (!bench_level(rng)) {
+        puts("Mismatch between ang_sort and sort_by_key");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}